@@ -12,6 +12,10 @@
 #include <string>
 #include <unistd.h>
 #include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
 
 // BattleShips project specific includes.
 #include "defines.h"
@@ -19,51 +23,208 @@
 #include "BoardV3.h"
 #include "AIContest.h"
 #include "conio.h"
+#include "ScreenBuffer.h"
 
 using namespace std;
 using namespace conio;
 
+const char* const AIContest::shipNames[MAX_SHIPS] = {
+    "Submarine", "Destroyer", "Aircraft Carrier",
+    "Destroyer 2", "Submarine 2", "Aircraft Carrier 2"
+};
+
+static long long nowNanoseconds() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+PlayerTiming::PlayerTiming() {
+    lateMoves = 0;
+    timeForfeits = 0;
+}
+
+void PlayerTiming::add( const PlayerTiming& other ) {
+    getMove.add(other.getMove);
+    update.add(other.update);
+    lateMoves += other.lateMoves;
+    timeForfeits += other.timeForfeits;
+}
+
+string PlayerTiming::toJson() const {
+    ostringstream out;
+    out << "{\"getMove\":" << getMove.toJson() << ",\"update\":" << update.toJson()
+	<< ",\"lateMoves\":" << lateMoves << ",\"timeForfeits\":" << timeForfeits << "}";
+    return out.str();
+}
+
 AIContest::AIContest( PlayerV2* player1, string player1Name, 
                       PlayerV2* player2, string player2Name,
-		      int boardSize, bool silent )
+		      int boardSize )
 {
     // Set up player 1
     this->player1 = player1;
-    this->player1Board = new BoardV3(boardSize);
+    this->player1V3 = dynamic_cast<PlayerV3*>(player1);
+    this->player1Board = BoardV3::create(boardSize);
     this->player1Name = player1Name;
     this->player1Won = false;
 
     // Set up player 2
     this->player2 = player2;
-    this->player2Board = new BoardV3(boardSize);
+    this->player2V3 = dynamic_cast<PlayerV3*>(player2);
+    this->player2Board = BoardV3::create(boardSize);
     this->player2Name = player2Name;
     this->player2Won = false;
 
     // General
     this->boardSize = boardSize;
-    this->silent = silent;
+    this->silent = true;
+    this->headless = false;
+    // Room for both boards and the shot results under them; the cursor
+    // waits below those.
+    this->screen = new ScreenBuffer(8+boardSize, 50 + max(boardSize+2, 50));
+    this->screen->setCursor(8+boardSize, 1);
+    boardTitles[0] = player1Name + "'s Board";
+    boardTitles[1] = player2Name + "'s Board";
+    finalTitles[0] = "Final status of " + player1Name + "'s board";
+    finalTitles[1] = "Final status of " + player2Name + "'s board";
 
     // Ship stuff
-    shipNames[0] = "Submarine";
-    shipNames[1] = "Destroyer";
-    shipNames[2] = "Aircraft Carrier";
-    shipNames[3] = "Destroyer 2";
-    shipNames[4] = "Submarine 2";
-    shipNames[5] = "Aircraft Carrier 2";
-    
     numShips = boardSize-2;
     if( numShips > MAX_SHIPS ) {
     	numShips = MAX_SHIPS;
     }
 
+    // Replay
+    this->replay = NULL;
+    this->player1Id = 0;
+    this->player2Id = 0;
+
+    // Timing
+    timing[0] = timing[1] = NULL;
+    moveLimit = gameLimit = 0;
+    gameTime[0] = gameTime[1] = 0;
+
+    // Pipelined turns
+    moveThread = NULL;
+    moveAsked = moveAnswered = false;
+    moveThreadStopping = false;
+    moveThreadReseed = false;
+    moveThreadSeed = 0;
+}
+
+void AIContest::setTiming( double moveSeconds, double gameSeconds,
+			   PlayerTiming* player1Timing, PlayerTiming* player2Timing ) {
+    moveLimit = (long long)(moveSeconds * 1e9);
+    gameLimit = (long long)(gameSeconds * 1e9);
+    timing[0] = player1Timing;
+    timing[1] = player2Timing;
+}
+
+void AIContest::setReplay( ReplayWriter* replay, int player1Id, int player2Id ) {
+    this->replay = replay;
+    this->player1Id = player1Id;
+    this->player2Id = player2Id;
+}
+
+void AIContest::reset( uint64_t gameSeed, bool silent, bool headless ) {
+    this->silent = silent || headless;
+    this->headless = headless;
+    player1Won = false;
+    player2Won = false;
+    player1Board->clear();
+    player2Board->clear();
+    gameTime[0] = gameTime[1] = 0;
+
+    // Everything random in the game comes from gameSeed: the provided
+    // binaries use rand(), PlayerV3 players their own stream, and the
+    // referee deals the ships from another.
+    threadRandom::seed(streamKey(gameSeed, LibraryStream));
+    if( moveThread ) {
+	lock_guard<mutex> guard(moveLock);
+	moveThreadSeed = streamKey(gameSeed, MoveThreadStream);
+	moveThreadReseed = true;
+    }
+    if( player1V3 ) player1V3->seedRandom(streamKey(gameSeed, Player1Stream));
+    if( player2V3 ) player2V3->seedRandom(streamKey(gameSeed, Player2Stream));
+    long long start = timing[0] ? nowNanoseconds() : 0;
+    player1->newRound();
+    if( timing[0] ) addTime(player1, start, NULL);
+    start = timing[1] ? nowNanoseconds() : 0;
+    player2->newRound();
+    if( timing[1] ) addTime(player2, start, NULL);
+
+    GameRandom dealer(streamKey(gameSeed, RefereeStream));
     for(int i=0; i<numShips; i++) {
-	shipLengths[i] = random()%(MIN_SHIP_SIZE) + 3;
+	shipLengths[i] = dealer.below(MIN_SHIP_SIZE) + 3;
+    }
+    if( replay ) {
+	record.begin(gameSeed, player1Id, player2Id, boardSize, shipLengths, numShips);
     }
 }
 
 AIContest::~AIContest() {
+    setPipelined(false);
     delete this->player1Board;
     delete this->player2Board;
+    delete this->screen;
+}
+
+bool AIContest::setPipelined( bool pipelined ) {
+    // With one core the threads would only take turns, and switching costs.
+    if( pipelined && thread::hardware_concurrency() < 2 ) pipelined = false;
+    if( pipelined == (moveThread != NULL) ) return pipelined;
+    if( pipelined ) {
+	moveThreadStopping = false;
+	moveThread = new thread(&AIContest::moveThreadLoop, this);
+	return true;
+    }
+    {
+	lock_guard<mutex> guard(moveLock);
+	moveThreadStopping = true;
+    }
+    moveWanted.notify_one();
+    moveThread->join();
+    delete moveThread;
+    moveThread = NULL;
+    return false;
+}
+
+void AIContest::moveThreadLoop() {
+    unique_lock<mutex> guard(moveLock);
+    while( true ) {
+	while( ! moveAsked && ! moveThreadStopping ) {
+	    moveWanted.wait(guard);
+	}
+	if( moveThreadStopping ) return;
+	moveAsked = false;
+	if( moveThreadReseed ) {
+	    threadRandom::seed(moveThreadSeed);
+	    moveThreadReseed = false;
+	}
+	// Player 2 is ours until we answer; the referee only talks to player 1.
+	guard.unlock();
+	Move move = askMove(player2);
+	guard.lock();
+	player2Move = move;
+	moveAnswered = true;
+	moveDone.notify_one();
+    }
+}
+
+void AIContest::startPlayer2Move() {
+    {
+	lock_guard<mutex> guard(moveLock);
+	moveAsked = true;
+    }
+    moveWanted.notify_one();
+}
+
+Move AIContest::finishPlayer2Move() {
+    unique_lock<mutex> guard(moveLock);
+    while( ! moveAnswered ) {
+	moveDone.wait(guard);
+    }
+    moveAnswered = false;
+    return player2Move;
 }
 
 /**
@@ -72,52 +233,54 @@ AIContest::~AIContest() {
 //bool AIContest::placeShips( PlayerV2* player, BoardV3* board, BoardV3* testingBoard ) {
 bool AIContest::placeShips( PlayerV2* player, BoardV3* board ) {
     for( int i=0; i<numShips; i++ ) {
-	Message loc = player->placeShip( shipLengths[i] );
-	bool placedOk = board->placeShip( loc.getRow(), loc.getCol(), shipLengths[i], loc.getDirection() );
+	Move loc = askPlacement( player, shipLengths[i] );
+	bool placedOk = board->placeShip( loc.row, loc.col, shipLengths[i], getDirection(loc) );
 	if( ! placedOk ) {
-	    cerr << "Error: couldn't place "<<shipNames[i]<<" (length "<<shipLengths[i]<<")"<<endl;
+	    if( ! headless ) {
+		cerr << "Error: couldn't place "<<shipNames[i]<<" (length "<<shipLengths[i]<<")"<<endl;
+	    }
 	    return false;
 	}
+	if( replay ) record.placement(board == player1Board ? 0 : 1, loc);
     }
 
     // All ships apparently placed ok.
     return true;
 }
 
-void AIContest::showBoard(BoardV3* board, bool ownerView, string playerName,
+void AIContest::showBoard(BoardV3* board, bool ownerView, const string& playerName,
 			  bool fullRedraw, Side side, bool hLMostRecentShot, int hLRow, int hLCol ) {
     if( silent ) return;
+    // Draws into the frame; play() sends each finished frame with present().
     // 'fullRedraw' indicates full board draw or only an update.
     // 'side' (Left / Right) indicates where to draw the board
 
     // Line 1: board name
     // Line 3: board columns
-    // Line 5-14: board rows
-    // Line 16: Shot location
-    // Line 17: shot results
+    // Line 5 on: board rows
+    // Two lines below the board: shot location and shot results
 
     char ch;
-    // Left board starts at column 1, right board at column 30
+    // Left board starts at column 1, right board at column 50
     int boardColOffset = side == Left ? 1 : 50;
 
-    cout << gotoRowCol(1, boardColOffset)
-         << playerName << flush;
+    screen->text(1, boardColOffset, playerName);
     // Top row
-    cout << gotoRowCol(3, boardColOffset) << " |";
+    screen->text(3, boardColOffset, " |");
+    int col = boardColOffset + 2;
     for(int count=0; count<boardSize; count++) {
-	cout << count;
+	screen->number(3, col, count);
+	col += count < 10 ? 1 : count < 100 ? 2 : 3;
     }
-    cout << flush;
 
-    cout << gotoRowCol(4, boardColOffset) << flush;
     // Put out horizontal header line
     for(int col=0; col<boardSize+2; col++) {
-	cout << '-';
+	screen->put(4, boardColOffset+col, '-');
     }
-    cout << flush;
 
     for(int row=0; row<boardSize; row++) {
-	cout << gotoRowCol(5+row, boardColOffset) << (char)(row+'A') << "|";
+	screen->put(5+row, boardColOffset, (char)(row+'A'));
+	screen->put(5+row, boardColOffset+1, '|');
 	for(int col=0; col<boardSize; col++) {
 	    if( ownerView == true ) {
 		ch = board->getOwnerView(row,col);
@@ -125,31 +288,25 @@ void AIContest::showBoard(BoardV3* board, bool ownerView, string playerName,
 		ch = board->getOpponentView(row,col);
 	    }
 
+	    ScreenBuffer::Style style = 0;
 	    switch(ch) {
-		case KILL: cout << fgColor(BLACK) << bgColor(LIGHT_RED); break;
-	        case HIT: cout << fgColor(BLACK) << bgColor(LIGHT_MAGENTA); break;
-	        case MISS: cout << fgColor(BLACK) << bgColor(GRAY); break;
-	        case WATER: cout << fgColor(BLACK) << bgColor(LIGHT_CYAN); break;
+		case KILL: style = ScreenBuffer::style(BLACK, LIGHT_RED); break;
+	        case HIT: style = ScreenBuffer::style(BLACK, LIGHT_MAGENTA); break;
+	        case MISS: style = ScreenBuffer::style(BLACK, GRAY); break;
+	        case WATER: style = ScreenBuffer::style(BLACK, LIGHT_CYAN); break;
 	    }
-	    if( ch>= 'a' && ch<='k' ) {
-		cout << setTextStyle( NEGATIVE_IMAGE ) << ch << resetAll() << flush;
-	    } else {
-		if( hLMostRecentShot && hLRow==row && hLCol==col ) {
-		    cout << setTextStyle( NEGATIVE_IMAGE ) << ch << setTextStyle( NEGATIVE_IMAGE ) << resetAll() << flush;
-		} else {
-		    cout << ch << resetAll() << flush;
-		}
+	    if( ( ch>= 'a' && ch<='k' ) || ( hLMostRecentShot && hLRow==row && hLCol==col ) ) {
+		style |= ScreenBuffer::style( NEGATIVE_IMAGE );
 	    }
+	    screen->put(5+row, boardColOffset+2+col, ch, style);
 	}
-	cout << resetAll() << flush;
     }
-    cout << resetAll() << endl;
 }
 
 // Clears the screen.
 void AIContest::clearScreen() {
     if( silent ) return;
-    cout << clrscr() << flush;
+    screen->clear();
 }
 
 void AIContest::snooze( float seconds ) {
@@ -158,57 +315,184 @@ void AIContest::snooze( float seconds ) {
     usleep(sleepTime);
 }
 
-void AIContest::updateAI(PlayerV2 *player, BoardV3 *board, int hitRow, int hitCol) {
-    Message killMsg( KILL, -1, -1, "");
-    char shipMark = board->getShipMark(hitRow, hitCol);
+PlayerV3* AIContest::asPlayerV3(PlayerV2 *player) {
+    return player == player1 ? player1V3 : player2V3;
+}
 
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    if(board->getShipMark(row,col) == shipMark) {
-	        killMsg.setRow(row);
-	        killMsg.setCol(col);
-		player->update(killMsg);
-	    }
+int AIContest::sideOf(PlayerV2 *player) {
+    return player == player1 ? 0 : 1;
+}
+
+/**
+ * Charges the time since start to the player's game, and records it in
+ * histogram if given.
+ */
+void AIContest::addTime(PlayerV2 *player, long long start, LatencyHistogram* histogram) {
+    long long took = nowNanoseconds() - start;
+    gameTime[sideOf(player)] += took;
+    if( histogram ) histogram->record(took);
+}
+
+Move AIContest::askMove(PlayerV2 *player) {
+    int side = sideOf(player);
+    long long start = timing[side] ? nowNanoseconds() : 0;
+    Move move;
+    PlayerV3 *fast = asPlayerV3(player);
+    if( fast ) {
+	move = fast->nextMove();
+    } else {
+	Message msg = player->getMove();
+	move = toMove(msg);
+    }
+    if( timing[side] ) {
+	long long before = gameTime[side];
+	addTime(player, start, &timing[side]->getMove);
+	if( moveLimit > 0 && gameTime[side] - before > moveLimit ) {
+	    timing[side]->lateMoves++;
+	    move = fallbackShot(side == 0 ? player2Board : player1Board);
 	}
     }
+    return move;
 }
 
-bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board, 
-                           Side side, int row, int col, PlayerV2 *otherPlayer) 
+Move AIContest::askPlacement(PlayerV2 *player, int length) {
+    long long start = timing[sideOf(player)] ? nowNanoseconds() : 0;
+    Move loc;
+    PlayerV3 *fast = asPlayerV3(player);
+    if( fast ) {
+	loc = fast->nextPlacement(length);
+    } else {
+	Message msg = player->placeShip(length);
+	loc = toMove(msg);
+    }
+    if( timing[sideOf(player)] ) addTime(player, start, NULL);
+    return loc;
+}
+
+void AIContest::tell(PlayerV2 *player, Move move) {
+    PlayerTiming* playerTiming = timing[sideOf(player)];
+    if( ! playerTiming ) {
+	deliver(player, move);
+	return;
+    }
+    long long start = nowNanoseconds();
+    deliver(player, move);
+    addTime(player, start, &playerTiming->update);
+}
+
+void AIContest::deliver(PlayerV2 *player, Move move) {
+    PlayerV3 *fast = asPlayerV3(player);
+    if( fast ) {
+	fast->notify(move);
+    } else {
+	player->update(toMessage(move));
+    }
+}
+
+/**
+ * The shot a player gets for a late move: the first cell, row by row, it
+ * hasn't shot at.
+ */
+Move AIContest::fallbackShot(BoardV3 *board) {
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=0; col<boardSize; col++ ) {
+	    if( board->getOpponentView(row, col) == WATER ) return makeMove(SHOT, row, col);
+	}
+    }
+    return makeMove(SHOT);
+}
+
+/**
+ * Ends the game if a player has used up its time: that player loses, or
+ * it's a tie if both have.
+ */
+void AIContest::overGameTime(bool& player1Won, bool& player2Won) {
+    bool over[2];
+    for( int side=0; side<2; side++ ) {
+	over[side] = timing[side] && gameLimit > 0 && gameTime[side] > gameLimit;
+    }
+    if( ! over[0] && ! over[1] ) return;
+    for( int side=0; side<2; side++ ) {
+	if( ! over[side] ) continue;
+	timing[side]->timeForfeits++;
+	if( ! headless ) {
+	    cout << endl << (side == 0 ? player1Name : player2Name)
+		 << " ran out of time and forfeits game." << endl << endl;
+	}
+    }
+    player1Won = over[1];
+    player2Won = over[0];
+}
+
+/**
+ * Tells the player it sank the ship at hitRow, hitCol: one notifyKill() for a
+ * PlayerV3, one KILL update() per ship cell for a PlayerV2.
+ */
+void AIContest::updateAI(PlayerV2 *player, BoardV3 *board, int hitRow, int hitCol) {
+    ShipLocation ship = board->getShip(hitRow, hitCol);
+    Move kill = makeMove( KILL, ship.row, ship.col, ship.dir, ship.length, ship.shipId );
+
+    PlayerTiming* playerTiming = timing[sideOf(player)];
+    long long start = playerTiming ? nowNanoseconds() : 0;
+    PlayerV3 *fast = asPlayerV3(player);
+    if( fast ) {
+	fast->notifyKill(kill);
+    } else {
+	for(int i=0; i<ship.length; i++) {
+	    player->update(toMessage(killCell(kill, i)));
+	}
+    }
+    if( playerTiming ) addTime(player, start, &playerTiming->update);
+}
+
+/**
+ * Processes a shot, tells the shooter the result and the other player the shot.
+ * With otherMovesNext (pipelined turns) the other player is told first and then
+ * asked for its move on the move thread, while the shooter is told the result.
+ */
+bool AIContest::processShot(const string& playerName, PlayerV2 *player, BoardV3 *board, 
+                           Side side, int row, int col, PlayerV2 *otherPlayer, bool otherMovesNext) 
 {
     bool won = false;
-    int resultsRow = 16;
+    int resultsRow = 6 + boardSize;
     int shotColOffset = side == Right ? 1 : 50;
     int boardColOffset = side == Left ? 1 : 50;
+    ScreenBuffer::Style errorStyle = ScreenBuffer::style(RED, WHITE);
+    char line[100];
     // Wipe any previous contents clean first
-    if( !silent ) cout << gotoRowCol( resultsRow, shotColOffset) << playerName 
-                       << "'s shot: [" <<row<< "," <<col<< "]" << endl;
-    Message msg = board->processShot( row, col );
-    // Hack because board doesn't set these properly.
-    msg.setRow(row);
-    msg.setCol(col);
-
-    switch( msg.getMessageType() ) {
+    if( !silent ) {
+	snprintf(line, sizeof(line), "%s's shot: [%d,%d]", playerName.c_str(), row, col);
+	screen->blank( resultsRow, shotColOffset, 48 );
+	screen->text( resultsRow, shotColOffset, line );
+    }
+    Move msg = makeMove( board->processShot( row, col ), row, col );
+    if( replay ) record.shot(row, col, msg.type);
+    if( otherMovesNext ) {
+	tell(otherPlayer, makeMove( OPPONENT_SHOT, row, col ));
+	startPlayer2Move();
+    }
+
+    switch( msg.type ) {
 	case MISS:
 	    // Swapped sides: boardColOffset => shotColOffset. Change back if necessary.
-	    //if( !silent ) cout << gotoRowCol( resultsRow+1, boardColOffset ) << setw(30) << "";
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "Miss" << flush;
-	    player->update(msg);
+	    //if( !silent ) screen->blank( resultsRow+1, boardColOffset, 30 );
+	    if( !silent ) screen->blank( resultsRow+1, shotColOffset, 30 );
+	    if( !silent ) screen->text( resultsRow+1, shotColOffset, "Miss" );
+	    tell(player, msg);
 	    break;
 	case HIT:
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "Hit" << flush;
-	    player->update(msg);
+	    if( !silent ) screen->blank( resultsRow+1, shotColOffset, 30 );
+	    if( !silent ) screen->text( resultsRow+1, shotColOffset, "Hit" );
+	    tell(player, msg);
 	    break;
 	case KILL:
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
-	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "It's a KILL! " << msg.getString() << flush;
+	    if( !silent ) screen->blank( resultsRow+1, shotColOffset, 30 );
+	    if( !silent ) screen->text( resultsRow+1, shotColOffset, "It's a KILL! " );
 	    // Notify that is a hit
-	    msg.setMessageType(HIT);
-	    player->update(msg);
+	    msg.type = HIT;
+	    tell(player, msg);
 	    // Probably not needed, but just to be safe ...
-	    msg.setMessageType(KILL);
+	    msg.type = KILL;
 	    // and notify that all segments of ship are now a KILL
 	    updateAI(player, board, row, col);
 
@@ -217,38 +501,34 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
 	    break;
 	case DUPLICATE_SHOT:
 	    if( !silent ) {
-		cout << fgColor(RED) << bgColor(WHITE);
-	        cout << gotoRowCol( resultsRow+1, boardColOffset ) << setw(30) << "";
-	        cout << gotoRowCol( resultsRow+1, boardColOffset ) << "You already shot there.";
-		cout << resetAll() << flush;
+	        screen->blank( resultsRow+1, boardColOffset, 30 );
+	        screen->text( resultsRow+1, boardColOffset, "You already shot there.", errorStyle );
 	    }
-	    player->update(msg);
+	    tell(player, msg);
 	    break;
 	case INVALID_SHOT:
 	    if( !silent ) {
-		cout << fgColor(RED) << bgColor(WHITE);
-		cout << gotoRowCol( resultsRow+1, boardColOffset ) << setw(30) << "";
-	        cout << gotoRowCol( resultsRow+1, boardColOffset ) << playerName << "Invalid coordinates: [row="<<row<<
-	             ", col="<<col<<"]" << flush;
-		cout << resetAll() << flush;
+		snprintf(line, sizeof(line), "%sInvalid coordinates: [row=%d, col=%d]", playerName.c_str(), row, col);
+	        screen->blank( resultsRow+1, boardColOffset, 30 );
+	        screen->text( resultsRow+1, boardColOffset, line, errorStyle );
 	    }
-	    player->update(msg);
+	    tell(player, msg);
 	    break;
 	default:
 	    if( !silent ) {
-		cout << fgColor(RED) << bgColor(WHITE);
-		cout << gotoRowCol( resultsRow+1, boardColOffset ) << setw(30) << "";
-	        cout << gotoRowCol( resultsRow+1, boardColOffset ) << "Invalid return from processShot: "
-	                       << msg.getMessageType() << "(" << msg.getString() << ")";
-		cout << resetAll() << flush;
+		snprintf(line, sizeof(line), "Invalid return from processShot: %c", msg.type);
+	        screen->blank( resultsRow+1, boardColOffset, 30 );
+	        screen->text( resultsRow+1, boardColOffset, line, errorStyle );
 	    }
-	    player->update(msg);
+	    tell(player, msg);
 	    break;
     }
 
     // Notify the other player of the shot
-    msg.setMessageType(OPPONENT_SHOT);
-    otherPlayer->update(msg);
+    if( ! otherMovesNext ) {
+	msg.type = OPPONENT_SHOT;
+	tell(otherPlayer, msg);
+    }
 
     return won;
 }
@@ -262,41 +542,53 @@ void AIContest::play( float secondsDelay, int& totalMoves, bool& player1Won, boo
     //BoardV3 testingBoard1(boardSize);
     //if( ! placeShips(player1, player1Board, testingBoard1) ) {
     if( ! placeShips(player1, player1Board) ) {
-	//if( ! silent ) {
+	if( ! headless ) {
 	    cout << endl;
 	    cout << player1Name << " placed ship in invalid location and forfeits game." << endl;
 	    cout << endl;
 	    snooze( secondsDelay*4 );
-	//}
+	}
 	player2Won = true;
     }
 
     //BoardV3 testingBoard2(boardSize);
     //if( ! placeShips(player2, player2Board, testingBoard2) ) {
     if( ! placeShips(player2, player2Board) ) {
-	//if( ! silent ) {
+	if( ! headless ) {
 	    cout << endl;
 	    cout << player2Name << " placed ship in invalid location and forfeits game." << endl;
 	    cout << endl;
 	    snooze( secondsDelay*4 );
-	//}
+	}
 	player1Won = true;
     }
-
+    if( ! (player1Won || player2Won) ) {
+	overGameTime(player1Won, player2Won);
+    }
 
     while ( !(player1Won || player2Won) && totalMoves < maxShots ){
 	//clearScreen();
 
-	Message shot1 = player1->getMove();
-	player1Won = processShot(player1Name, player1, player2Board, Left, shot1.getRow(), shot1.getCol(), player2);
-	Message shot2 = player2->getMove();
-	player2Won = processShot(player2Name, player2, player1Board, Right, shot2.getRow(), shot2.getCol(), player1);
+	Move shot1, shot2;
+	if( moveThread ) {
+	    shot1 = askMove(player1);
+	    player1Won = processShot(player1Name, player1, player2Board, Left, shot1.row, shot1.col, player2, true);
+	    shot2 = finishPlayer2Move();
+	    player2Won = processShot(player2Name, player2, player1Board, Right, shot2.row, shot2.col, player1);
+	} else {
+	    shot1 = askMove(player1);
+	    player1Won = processShot(player1Name, player1, player2Board, Left, shot1.row, shot1.col, player2);
+	    shot2 = askMove(player2);
+	    player2Won = processShot(player2Name, player2, player1Board, Right, shot2.row, shot2.col, player1);
+	}
+	overGameTime(player1Won, player2Won);
 
 	if( ! silent ) {
-	    showBoard(player1Board, false, player1Name + "'s Board", false, Left, true, shot2.getRow(), shot2.getCol());
+	    showBoard(player1Board, false, boardTitles[0], false, Left, true, shot2.row, shot2.col);
 	}
 	if( ! silent ) {
-	    showBoard(player2Board, false, player2Name + "'s Board", false, Right, true, shot1.getRow(), shot1.getCol());
+	    showBoard(player2Board, false, boardTitles[1], false, Right, true, shot1.row, shot1.col);
+	    screen->present();
 	}
 
 	totalMoves++;
@@ -311,40 +603,49 @@ void AIContest::play( float secondsDelay, int& totalMoves, bool& player1Won, boo
 
     if( ! silent ) {
 	clearScreen();
-	showBoard(player1Board, true, "Final status of " + player1Name + "'s board", 
+	showBoard(player1Board, true, finalTitles[0],
 	          true, Left, false, -1, -1);
-	cout << endl;
-	showBoard(player2Board, true, "Final status of " + player2Name + "'s board", 
+	showBoard(player2Board, true, finalTitles[1],
 	          true, Right, false, -1, -1);
-	cout << endl;
+	// What follows is printed under the boards.
+	screen->setCursor(6+boardSize, 1);
+	screen->present();
+	screen->setCursor(8+boardSize, 1);
+    }
+
+    if( replay ) {
+	record.end(player1Won, player2Won);
+	replay->write(record.bytes());
     }
 
     if( player1Won && player2Won ) {
-	cout << "The game was a tie. Both players sunk all ships." << endl;
-	Message msg(TIE);
-	player1->update(msg);
-	player2->update(msg);
+	if( ! headless ) cout << "The game was a tie. Both players sunk all ships." << endl;
+	Move msg = makeMove(TIE);
+	tell(player1, msg);
+	tell(player2, msg);
     } else if( player1Won ) {
-	cout << player1Name << " won." << endl;
-	Message msg(WIN);
-	player1->update(msg);
-	msg.setMessageType(LOSE);
-	player2->update(msg);
+	if( ! headless ) cout << player1Name << " won." << endl;
+	Move msg = makeMove(WIN);
+	tell(player1, msg);
+	msg.type = LOSE;
+	tell(player2, msg);
     } else if( player2Won ) {
-	cout << player2Name << " won." << endl;
-	Message msg(WIN);
-	player2->update(msg);
-	msg.setMessageType(LOSE);
-	player1->update(msg);
+	if( ! headless ) cout << player2Name << " won." << endl;
+	Move msg = makeMove(WIN);
+	tell(player2, msg);
+	msg.type = LOSE;
+	tell(player1, msg);
     } else {   // both timed out -- neither won
-	cout << "The game was a tie. Neither player sunk all ships." << endl;
-	Message msg(LOSE);
-	player1->update(msg);
-	player2->update(msg);
-    }
-    cout << "--- (Moves = " << totalMoves << ", percentage of board shot at = " <<
-			    (100.0*(float)totalMoves)/(boardSize*boardSize) << "%.)" << endl;
-    cout << endl;
+	if( ! headless ) cout << "The game was a tie. Neither player sunk all ships." << endl;
+	Move msg = makeMove(LOSE);
+	tell(player1, msg);
+	tell(player2, msg);
+    }
+    if( ! headless ) {
+	cout << "--- (Moves = " << totalMoves << ", percentage of board shot at = " <<
+				(100.0*(float)totalMoves)/(boardSize*boardSize) << "%.)" << endl;
+	cout << endl;
+    }
     if( ! silent ) {
 	snooze( 5 );
     }
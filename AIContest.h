@@ -10,50 +10,162 @@
 #ifndef AICONTEST_H
 #define AICONTEST_H
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 // BattleShips project specific includes.
 #include "Message.h"
 #include "BoardV3.h"
 #include "PlayerV2.h"
+#include "PlayerV3.h"
+#include "Move.h"
+#include "GameRandom.h"
+#include "ReplayLog.h"
+#include "ScreenBuffer.h"
+#include "LatencyHistogram.h"
 
 using namespace std;
 
+/**
+ * How long one player's calls took (see AIContest::setTiming()). A kill
+ * counts as one update, however many cells the ship had.
+ */
+struct PlayerTiming {
+    LatencyHistogram getMove;
+    LatencyHistogram update;
+    int lateMoves;	// Over the move limit; a fallback shot went instead
+    int timeForfeits;	// Games lost for going over the game limit
+
+    PlayerTiming();
+    void add( const PlayerTiming& other );
+    string toJson() const;
+};
+
 class AIContest {
   public:
+    /**
+     * Sets up a match between two players: makes the boards, which every
+     * game of the match reuses. Call reset() before each game.
+     */
     AIContest( PlayerV2* player1, string player1Name,
                PlayerV2* player2, string player2Name,
-	       int boardSize, bool silent );
+	       int boardSize );
     ~AIContest();
+
+    /**
+     * Sets up the next game: clears the boards, seeds every random stream of
+     * the game from gameSeed (see GameRandom.h), starts a new round for both
+     * players and deals the ships. Nothing is allocated.
+     */
+    void reset( uint64_t gameSeed, bool silent, bool headless = false );
+
+    /**
+     * Records every game from the next reset() on into replay (see
+     * ReplayLog.h), under the given player ids. NULL turns recording off.
+     */
+    void setReplay( ReplayWriter* replay, int player1Id, int player2Id );
+
+    /**
+     * Times every call to the players from the next reset() on, adding
+     * them to player1Timing and player2Timing (NULL for both turns timing
+     * off). A move that takes over moveSeconds is replaced by a fallback
+     * shot at the first cell not shot at yet. A player whose calls in one
+     * game, placement and newRound() included, add up to over gameSeconds
+     * forfeits it. 0 means no limit.
+     * A call can't be interrupted, so a limit is applied when the call
+     * returns; a player that may never return belongs in an engine
+     * (EnginePlayer.h), which is killed when it stops answering.
+     */
+    void setTiming( double moveSeconds, double gameSeconds,
+                    PlayerTiming* player1Timing, PlayerTiming* player2Timing );
+
+    /**
+     * Pipelined turns: once player 1's shot is processed, player 2 is told
+     * about it and then chooses its move on a thread of its own, while the
+     * referee's thread tells player 1 how its shot went. Each player gets
+     * the same calls in the same order as in an unpipelined game; only
+     * player 1's results overlap player 2's move. PlayerV3 players play the
+     * same games either way. Players that use rand() draw from another
+     * stream on the move thread (MoveThreadStream), so their games differ
+     * from unpipelined ones, but not from run to run. Returns whether turns
+     * are pipelined: never on a machine with one core.
+     */
+    bool setPipelined( bool pipelined );
     void play( float secondsDelay, int& totalMoves, bool& player1Won, bool& player2Won );
 
   private:
     enum Side { Left=1, Right=2 };
     //bool placeShips( PlayerV2* player, BoardV3* board, BoardV3* testingBoard );
     bool placeShips( PlayerV2* player, BoardV3* board);
-    void showBoard(BoardV3* board, bool ownerView, string playerName,
+    void showBoard(BoardV3* board, bool ownerView, const string& playerName,
                    bool fullRedraw, Side side, bool hLMostRecentShot, int hLRow, int hLCol );
     void clearScreen();
     void updateAI(PlayerV2 *player, BoardV3 *board, int hitRow, int hitCol);
     void snooze(float seconds);
-    bool processShot(string playerName, PlayerV2 *player, BoardV3 *board, Side side, int row, int col, PlayerV2* otherPlayer);
+    bool processShot(const string& playerName, PlayerV2 *player, BoardV3 *board, Side side, int row, int col,
+                     PlayerV2* otherPlayer, bool otherMovesNext = false);
+
+    // Talk to a player in Moves; PlayerV2-only players go through Message.
+    PlayerV3* asPlayerV3(PlayerV2 *player);
+    Move askMove(PlayerV2 *player);
+    Move askPlacement(PlayerV2 *player, int length);
+    void tell(PlayerV2 *player, Move move);
+    void deliver(PlayerV2 *player, Move move);
+
+    // Timing (setTiming())
+    int sideOf(PlayerV2 *player);
+    void addTime(PlayerV2 *player, long long start, LatencyHistogram* histogram);
+    Move fallbackShot(BoardV3 *board);
+    void overGameTime(bool& player1Won, bool& player2Won);
+
+    // Pipelined turns (setPipelined())
+    void moveThreadLoop();
+    void startPlayer2Move();
+    Move finishPlayer2Move();
 
     // Data
     PlayerV2 *player1;
     PlayerV2 *player2;
+    PlayerV3 *player1V3;	// player1 as a PlayerV3, or NULL
+    PlayerV3 *player2V3;
     BoardV3 *player1Board;
     //BoardV3 *player1testingBoard;
     BoardV3 *player2Board;
     //BoardV3 *player2testingBoard;
+    ScreenBuffer *screen;	// Frame the visual games are drawn in
+    string boardTitles[2];	// Made once, so drawing allocates nothing
+    string finalTitles[2];
     string player1Name;
     string player2Name;
     int boardSize;
     bool silent;
+    bool headless;	// Batch mode: no output and no pauses at all.
     bool player1Won;
     bool player2Won;
     int NumShips;
     static const int MAX_SHIPS = 6;
-    string shipNames[MAX_SHIPS];
+    static const char* const shipNames[MAX_SHIPS];
     int shipLengths[MAX_SHIPS];
     int numShips;
+    ReplayWriter* replay;	// Where to record games, or NULL
+    GameRecord record;
+    int player1Id;
+    int player2Id;
+    PlayerTiming* timing[2];	// NULL: calls aren't timed
+    long long moveLimit;	// Nanoseconds; 0 = none
+    long long gameLimit;
+    long long gameTime[2];	// Each side's time so far this game
+    thread* moveThread;		// Asks player 2 for its moves, or NULL
+    mutex moveLock;		// Guards the rest
+    condition_variable moveWanted;
+    condition_variable moveDone;
+    bool moveAsked;
+    bool moveAnswered;
+    bool moveThreadStopping;
+    bool moveThreadReseed;	// Seed rand() with moveThreadSeed first
+    uint64_t moveThreadSeed;
+    Move player2Move;
 };
 
 #endif
@@ -32,7 +32,7 @@ AITester::AITester( PlayerV2* player, BoardV2* playerBoard, string playerName, i
     this->playerWon = false;
     this->placedShipsBoardCol = 20;
     this->placedShipsBoardRow = 5;
-    this->testingBoard = new BoardV3(boardSize);
+    this->testingBoard = BoardV3::create(boardSize);
 }
 
 /**
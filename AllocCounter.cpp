@@ -0,0 +1,48 @@
+/**
+ * AllocCounter.cpp: counts heap allocations made through operator new.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef ALLOCCOUNTER_CPP	// Double inclusion protection
+#define ALLOCCOUNTER_CPP
+
+#include <cstdlib>
+#include <new>
+
+#include "AllocCounter.h"
+
+static thread_local long long allocations = 0;
+
+long long allocationCount() {
+    return allocations;
+}
+
+void* operator new( size_t size ) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if( ! p ) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[]( size_t size ) {
+    return operator new(size);
+}
+
+void operator delete( void* p ) noexcept {
+    free(p);
+}
+
+void operator delete[]( void* p ) noexcept {
+    free(p);
+}
+
+void operator delete( void* p, size_t ) noexcept {
+    free(p);
+}
+
+void operator delete[]( void* p, size_t ) noexcept {
+    free(p);
+}
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * AllocCounter.h: counts heap allocations made through operator new.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Linking AllocCounter.o into a program replaces the global operator new and
+ * delete with versions that count calls. Only the bench links it in.
+ */
+
+#ifndef ALLOCCOUNTER_H		// Double inclusion protection
+#define ALLOCCOUNTER_H
+
+/**
+ * @brief Number of operator new calls made by this thread so far.
+ */
+long long allocationCount();
+
+#endif
@@ -0,0 +1,253 @@
+/**
+ * BatchSimulator.h: plays many games of two batch strategies in lockstep.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * AIContest plays one game at a time through virtual calls, two Board
+ * objects and a message per shot. BatchSimulator plays a block of games
+ * (lanes) together: every turn it asks each strategy for all of its shots,
+ * then referees them, then tells it the results, one tight loop per phase.
+ * The referee's state is struct-of-arrays CellMasks per side and lane, so a
+ * shot is a few ANDs and ORs, and winning is (ships & ~shots) == 0. Lanes
+ * whose game is over drop out of the active list; a new block starts when
+ * every lane is done.
+ *
+ * The rules are AIContest's: the same dealt ships (from the game's referee
+ * stream), the same placement checks and forfeits, both sides shoot every
+ * turn, a tie if both or neither sink the other's fleet by 2*boardSize^2
+ * turns, and the strategies get the same keys AIContest gives the players.
+ * So game g of a batch seeded s is game g of `testAI -s s`, and the totals
+ * match the tester's for the same players (see BatchPlayer).
+ */
+
+#ifndef BATCHSIMULATOR_H	// Double inclusion protection
+#define BATCHSIMULATOR_H
+
+#include <vector>
+
+#include "BatchStrategy.h"
+#include "GameRandom.h"
+#include "CellMask.h"
+#include "PlacementTable.h"
+#include "Move.h"
+#include "defines.h"
+
+using namespace std;
+
+/**
+ * Match totals, counted as the tester counts them.
+ */
+struct BatchResult {
+    int games;
+    int wins[2];
+    int ties;
+    long long shotsTaken[2];	// Turns of the games won, and of ties
+    int gamesCounted[2];
+};
+
+inline void clearBatchResult( BatchResult& result ) {
+    result.games = result.ties = 0;
+    for( int side=0; side<2; side++ ) {
+	result.wins[side] = result.gamesCounted[side] = 0;
+	result.shotsTaken[side] = 0;
+    }
+}
+
+inline void addBatchResult( BatchResult& total, const BatchResult& part ) {
+    total.games += part.games;
+    total.ties += part.ties;
+    for( int side=0; side<2; side++ ) {
+	total.wins[side] += part.wins[side];
+	total.shotsTaken[side] += part.shotsTaken[side];
+	total.gamesCounted[side] += part.gamesCounted[side];
+    }
+}
+
+template<class Strategy1, class Strategy2>
+class BatchSimulator {
+    public:
+	BatchSimulator( int boardSize, int lanes );
+
+	/**
+	 * @brief Plays games firstGame to firstGame+numGames-1 of the match
+	 * seeded with seed (game g uses gameSeed(seed, 0, g)) and adds them to
+	 * result.
+	 */
+	void play( uint64_t seed, int firstGame, int numGames, BatchResult& result );
+
+    private:
+	static const int MaxShips = 6;	// AIContest::MAX_SHIPS
+
+	template<class Strategy> bool placeFleet( Strategy& strategy, int side, int lane );
+	template<class Strategy> void fire( Strategy& strategy, int side );
+	void finish( int lane, bool player1Won, bool player2Won, int turns, BatchResult& result );
+
+	Strategy1 player1;
+	Strategy2 player2;
+	int boardSize;
+	int numLanes;
+	int numShips;
+	CellMask outside;
+
+	// The ships of side 0 (player 1) and side 1, per lane.
+	vector<unsigned char> shipLengths;	// [ship*numLanes + lane]
+	vector<CellMask> ships[2];		// [ship*numLanes + lane]
+	vector<Move> shipMoves[2];		// [ship*numLanes + lane], as KILL moves
+	vector<CellMask> fleetCells[2];		// [lane]
+	vector<CellMask> shotCells[2];		// [lane]: the other side's shots
+
+	vector<int> active;			// Lanes still playing
+	vector<Move> shots;			// [lane], this turn's
+};
+
+template<class Strategy1, class Strategy2>
+BatchSimulator<Strategy1, Strategy2>::BatchSimulator( int boardSize, int lanes )
+    : player1(boardSize, lanes), player2(boardSize, lanes), shots(lanes)
+{
+    this->boardSize = boardSize;
+    this->numLanes = lanes;
+    numShips = boardSize-2 < MaxShips ? boardSize-2 : MaxShips;
+    outside = outsideBoard(boardSize);
+    shipLengths.resize(MaxShips*lanes);
+    for( int side=0; side<2; side++ ) {
+	ships[side].resize(MaxShips*lanes);
+	shipMoves[side].resize(MaxShips*lanes);
+	fleetCells[side].resize(lanes);
+	shotCells[side].resize(lanes);
+    }
+    active.reserve(lanes);
+}
+
+/**
+ * As AIContest::placeShips(): the first bad placement forfeits the game,
+ * and any direction other than Horizontal is Vertical.
+ */
+template<class Strategy1, class Strategy2>
+template<class Strategy>
+bool BatchSimulator<Strategy1, Strategy2>::placeFleet( Strategy& strategy, int side, int lane ) {
+    CellMask placed = 0;
+    for( int i=0; i<numShips; i++ ) {
+	int length = shipLengths[i*numLanes + lane];
+	Move loc = strategy.place(lane, length);
+	bool horiz = getDirection(loc) == Horizontal;
+	CellMask cells = placementMask(length, horiz, loc.row, loc.col);
+	if( cells & (placed | outside) ) {
+	    return false;
+	}
+	placed |= cells;
+	ships[side][i*numLanes + lane] = cells;
+	shipMoves[side][i*numLanes + lane] = makeMove( KILL, loc.row, loc.col, horiz ? Horizontal : Vertical, length, i );
+    }
+    fleetCells[side][lane] = placed;
+    return true;
+}
+
+/**
+ * One side's shots for every active lane: ask, referee, tell.
+ */
+template<class Strategy1, class Strategy2>
+template<class Strategy>
+void BatchSimulator<Strategy1, Strategy2>::fire( Strategy& strategy, int side ) {
+    int target = 1 - side;
+    for( size_t i=0; i<active.size(); i++ ) {
+	shots[active[i]] = strategy.shoot(active[i]);
+    }
+    for( size_t i=0; i<active.size(); i++ ) {
+	int lane = active[i];
+	Move& shot = shots[lane];
+	int row = shot.row, col = shot.col;
+	if( row < 0 || row >= boardSize || col < 0 || col >= boardSize ) {
+	    strategy.result(lane, makeMove( INVALID_SHOT, row, col ));
+	    continue;
+	}
+	CellMask cell = cellBit(row, col);
+	if( shotCells[target][lane] & cell ) {
+	    strategy.result(lane, makeMove( DUPLICATE_SHOT, row, col ));
+	    continue;
+	}
+	CellMask shotAt = shotCells[target][lane] |= cell;
+	if( ! (fleetCells[target][lane] & cell) ) {
+	    strategy.result(lane, makeMove( MISS, row, col ));
+	    continue;
+	}
+	strategy.result(lane, makeMove( HIT, row, col ));
+	for( int k=0; k<numShips; k++ ) {
+	    CellMask ship = ships[target][k*numLanes + lane];
+	    if( ship & cell ) {
+		if( (ship & ~shotAt) == 0 ) {
+		    strategy.sunk(lane, shipMoves[target][k*numLanes + lane]);
+		}
+		break;
+	    }
+	}
+    }
+}
+
+/**
+ * Counts a game as the tester does.
+ */
+template<class Strategy1, class Strategy2>
+void BatchSimulator<Strategy1, Strategy2>::finish( int lane, bool player1Won, bool player2Won, int turns, BatchResult& result ) {
+    result.games++;
+    if( player1Won == player2Won ) {
+	result.ties++;
+	for( int side=0; side<2; side++ ) {
+	    result.shotsTaken[side] += turns;
+	    result.gamesCounted[side]++;
+	}
+    } else {
+	int winner = player1Won ? 0 : 1;
+	result.wins[winner]++;
+	result.shotsTaken[winner] += turns;
+	result.gamesCounted[winner]++;
+    }
+}
+
+template<class Strategy1, class Strategy2>
+void BatchSimulator<Strategy1, Strategy2>::play( uint64_t seed, int firstGame, int numGames, BatchResult& result ) {
+    int maxShots = 2*boardSize*boardSize;
+    for( int block=0; block<numGames; block+=numLanes ) {
+	int lanes = numGames - block < numLanes ? numGames - block : numLanes;
+
+	// Deal, and place the fleets, as AIContest::reset() and play().
+	active.clear();
+	for( int lane=0; lane<lanes; lane++ ) {
+	    uint64_t game = gameSeed(seed, 0, firstGame + block + lane);
+	    player1.start(lane, streamKey(game, Player1Stream));
+	    player2.start(lane, streamKey(game, Player2Stream));
+	    GameRandom dealer(streamKey(game, RefereeStream));
+	    for( int i=0; i<numShips; i++ ) {
+		shipLengths[i*numLanes + lane] = dealer.below(MIN_SHIP_SIZE) + 3;
+	    }
+	    shotCells[0][lane] = shotCells[1][lane] = 0;
+	    bool placed1 = placeFleet(player1, 0, lane);
+	    bool placed2 = placeFleet(player2, 1, lane);
+	    if( placed1 && placed2 ) {
+		active.push_back(lane);
+	    } else {
+		finish(lane, ! placed2, ! placed1, 0, result);
+	    }
+	}
+
+	for( int turn=1; turn<=maxShots && ! active.empty(); turn++ ) {
+	    fire(player1, 0);
+	    fire(player2, 1);
+	    size_t playing = 0;
+	    for( size_t i=0; i<active.size(); i++ ) {
+		int lane = active[i];
+		bool player1Won = (fleetCells[1][lane] & ~shotCells[1][lane]) == 0;
+		bool player2Won = (fleetCells[0][lane] & ~shotCells[0][lane]) == 0;
+		if( player1Won || player2Won ) {
+		    finish(lane, player1Won, player2Won, turn, result);
+		} else if( turn == maxShots ) {
+		    finish(lane, false, false, turn, result);
+		} else {
+		    active[playing++] = lane;
+		}
+	    }
+	    active.resize(playing);
+	}
+    }
+}
+
+#endif
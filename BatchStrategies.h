@@ -0,0 +1,356 @@
+/**
+ * BatchStrategies.h: the strategies the batch simulator can play.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * HuntStrategy is HuntPlayer move for move: it takes the same random numbers
+ * in the same order, so a game plays exactly as it does in the tester.
+ * ScanStrategy and DensityStrategy are simpler players of their own that
+ * borrow two of USSWhite's hunting ideas: the diagonal scan of
+ * getCleanPlayerScanMove() and the placement-density board. Both follow up
+ * hits by walking along them, much like branchOut(). They are not USSWhite
+ * with parts switched off: how they follow up hits, break ties and place
+ * ships differs, and nothing has checked them against USSWhite's games. They
+ * have no learning across rounds, fleet targeting or learned placements.
+ *
+ * The members are defined here, not in a .cpp, so that BatchSimulator's
+ * loops can inline them.
+ */
+
+#ifndef BATCHSTRATEGIES_H	// Double inclusion protection
+#define BATCHSTRATEGIES_H
+
+#include <vector>
+#include <algorithm>
+
+#include "BatchStrategy.h"
+
+using namespace std;
+
+class HuntStrategy : public BatchStrategy<HuntStrategy> {
+    public:
+	HuntStrategy( int boardSize, int lanes );
+	void startLane( int lane );
+	Move placeShip( int lane, int length ) { return placeRandomly(lane, length); }
+	Move chooseShot( int lane );
+	void onHit( int lane, int row, int col );
+
+    private:
+	static const int MaxHuntCells = MAX_BOARD_SIZE*MAX_BOARD_SIZE/MIN_SHIP_SIZE + 1;
+	static const int MaxTargets = 4*MAX_BOARD_SIZE*MAX_BOARD_SIZE;	// 4 per hit at most
+
+	void addTarget( int lane, int row, int col );
+
+	// Per lane, as HuntPlayer's members; cells are CellMask bit numbers.
+	vector<unsigned char> huntCells;	// [lane*MaxHuntCells + i]
+	vector<unsigned char> numHuntCells;
+	vector<unsigned char> nextHunt;
+	vector<unsigned char> targets;		// [lane*MaxTargets + i], a stack
+	vector<short> numTargets;
+	vector<short> nextScan;			// Row-major, row*boardSize + col
+};
+
+class ScanStrategy : public BatchStrategy<ScanStrategy> {
+    public:
+	ScanStrategy( int boardSize, int lanes );
+	void startLane( int lane );
+	Move placeShip( int lane, int length ) { return placeRandomly(lane, length); }
+	Move chooseShot( int lane );
+
+    private:
+	bool branchOut( int lane, int& row, int& col );
+	void stepScan( int& row, int& col );
+
+	vector<signed char> scanRow;	// Last scan shot, per lane
+	vector<signed char> scanCol;
+};
+
+class DensityStrategy : public BatchStrategy<DensityStrategy> {
+    public:
+	DensityStrategy( int boardSize, int lanes );
+	void startLane( int lane );
+	Move placeShip( int lane, int length ) { return placeRandomly(lane, length); }
+	Move chooseShot( int lane );
+	void onMiss( int lane, int row, int col );
+	void onSunk( int lane, Move ship );
+
+    private:
+	static const int Cells = MAX_BOARD_SIZE*MAX_BOARD_SIZE;
+
+	void countRow( int lane, int row );
+	void countCol( int lane, int col );
+
+	// Per lane, kept like USSWhite's probabilityBoard: a miss recounts its
+	// row and column, a sinking (the fleet afloat changes) every line.
+	vector<unsigned short> openRows;	// [lane*MAX_BOARD_SIZE + row]: bit col is not a miss or sunk
+	vector<unsigned short> openCols;	// [lane*MAX_BOARD_SIZE + col]: bit row likewise
+	vector<short> rowDensity;		// [lane*Cells + row*MAX_BOARD_SIZE + col]
+	vector<short> colDensity;		// Same layout
+	vector<FleetCounts> afloat;
+	vector<char> recount;			// Every line, before the next shot
+};
+
+// HuntStrategy
+
+inline HuntStrategy::HuntStrategy( int boardSize, int lanes )
+    : BatchStrategy<HuntStrategy>(boardSize, lanes),
+      huntCells(lanes*MaxHuntCells), numHuntCells(lanes), nextHunt(lanes),
+      targets(lanes*MaxTargets), numTargets(lanes), nextScan(lanes)
+{
+}
+
+inline void HuntStrategy::startLane( int lane ) {
+    numTargets[lane] = 0;
+    nextScan[lane] = 0;
+
+    int offset = random[lane].below(MIN_SHIP_SIZE);
+    unsigned char* cells = &huntCells[lane*MaxHuntCells];
+    int numCells = 0;
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=0; col<boardSize; col++ ) {
+	    if( (row + col) % MIN_SHIP_SIZE == offset ) {
+		cells[numCells++] = row*CellMaskStride + col;
+	    }
+	}
+    }
+    for( int i=numCells-1; i>0; i-- ) {
+	swap(cells[i], cells[random[lane].below(i+1)]);
+    }
+    numHuntCells[lane] = numCells;
+    nextHunt[lane] = 0;
+}
+
+inline Move HuntStrategy::chooseShot( int lane ) {
+    CellMask shot = shotCells[lane];
+    unsigned char* stack = &targets[lane*MaxTargets];
+    while( numTargets[lane] > 0 ) {
+	int cell = stack[--numTargets[lane]];
+	if( ! ((shot >> cell) & 1) ) {
+	    return makeMove( SHOT, cell / CellMaskStride, cell % CellMaskStride );
+	}
+    }
+    const unsigned char* cells = &huntCells[lane*MaxHuntCells];
+    while( nextHunt[lane] < numHuntCells[lane] ) {
+	int cell = cells[nextHunt[lane]++];
+	if( ! ((shot >> cell) & 1) ) {
+	    return makeMove( SHOT, cell / CellMaskStride, cell % CellMaskStride );
+	}
+    }
+    int scan = nextScan[lane];
+    while( scan < boardSize*boardSize && hasCell(shot, scan / boardSize, scan % boardSize) ) {
+	scan++;
+    }
+    nextScan[lane] = scan;
+    if( scan >= boardSize*boardSize ) scan = 0;
+    return makeMove( SHOT, scan / boardSize, scan % boardSize );
+}
+
+inline void HuntStrategy::addTarget( int lane, int row, int col ) {
+    if( unshot(lane, row, col) && numTargets[lane] < MaxTargets ) {
+	targets[lane*MaxTargets + numTargets[lane]++] = row*CellMaskStride + col;
+    }
+}
+
+inline void HuntStrategy::onHit( int lane, int row, int col ) {
+    addTarget(lane, row-1, col);
+    addTarget(lane, row+1, col);
+    addTarget(lane, row, col-1);
+    addTarget(lane, row, col+1);
+}
+
+// ScanStrategy
+
+inline ScanStrategy::ScanStrategy( int boardSize, int lanes )
+    : BatchStrategy<ScanStrategy>(boardSize, lanes), scanRow(lanes), scanCol(lanes)
+{
+}
+
+inline void ScanStrategy::startLane( int lane ) {
+    scanRow[lane] = 0;
+    scanCol[lane] = -MIN_SHIP_SIZE;
+}
+
+/**
+ * From the first hit not yet sunk, walk along the hits to water: up and down
+ * first if the hit has a hit above or below it, else left and right first.
+ */
+inline bool ScanStrategy::branchOut( int lane, int& row, int& col ) {
+    static const int steps[2][4][2] = {
+	{ {0,-1}, {0,1}, {-1,0}, {1,0} },	// Across first
+	{ {-1,0}, {1,0}, {0,-1}, {0,1} }	// Down first
+    };
+    CellMask hits = hitCells[lane];
+    while( hits ) {
+	int cell = firstCell(hits);
+	hits &= hits - 1;
+	int hitRow = cell / CellMaskStride, hitCol = cell % CellMaskStride;
+	bool vertical = (hitRow > 0 && hasCell(hitCells[lane], hitRow-1, hitCol))
+		     || (hitRow+1 < boardSize && hasCell(hitCells[lane], hitRow+1, hitCol));
+	for( int i=0; i<4; i++ ) {
+	    if( firstUnshot(lane, hitRow, hitCol, steps[vertical][i][0], steps[vertical][i][1], row, col) ) {
+		return true;
+	    }
+	}
+    }
+    return false;
+}
+
+// As USSWhite::adjustShotToBeNew().
+inline void ScanStrategy::stepScan( int& row, int& col ) {
+    col++;
+    if( col >= boardSize ) {
+	col = 0;
+	row++;
+    }
+    if( row >= boardSize ) {
+	row = 0;
+    }
+}
+
+inline Move ScanStrategy::chooseShot( int lane ) {
+    int row, col;
+    if( branchOut(lane, row, col) ) {
+	return makeMove( SHOT, row, col );
+    }
+
+    // After USSWhite::getCleanPlayerScanMove(): every MIN_SHIP_SIZE'th cell along
+    // the rows, skipping cells under a miss. Once no such cell is left, any
+    // unshot cell will do.
+    row = scanRow[lane];
+    col = scanCol[lane] + MIN_SHIP_SIZE;
+    if( col >= boardSize ) {
+	row++;
+	if( row >= boardSize ) row = 0;
+	col = row % MIN_SHIP_SIZE;
+    }
+    bool found = false;
+    for( int pass=0; pass<2 && ! found; pass++ ) {
+	for( int tries=0; tries<boardSize*boardSize; tries++ ) {
+	    if( unshot(lane, row, col) && (pass == 1 || row == 0 || ! hasCell(missCells[lane], row-1, col)) ) {
+		found = true;
+		break;
+	    }
+	    stepScan(row, col);
+	}
+    }
+    scanRow[lane] = row;
+    scanCol[lane] = col;
+    return makeMove( SHOT, row, col );
+}
+
+// DensityStrategy
+
+inline DensityStrategy::DensityStrategy( int boardSize, int lanes )
+    : BatchStrategy<DensityStrategy>(boardSize, lanes),
+      openRows(lanes*MAX_BOARD_SIZE), openCols(lanes*MAX_BOARD_SIZE),
+      rowDensity(lanes*Cells), colDensity(lanes*Cells), afloat(lanes), recount(lanes)
+{
+}
+
+inline void DensityStrategy::startLane( int lane ) {
+    for( int i=0; i<MAX_BOARD_SIZE; i++ ) {
+	openRows[lane*MAX_BOARD_SIZE + i] = openCols[lane*MAX_BOARD_SIZE + i] = (1 << boardSize) - 1;
+    }
+    recount[lane] = true;	// The fleet comes with the placements.
+}
+
+/**
+ * Placements of the ships afloat that cover each cell of a row (or column),
+ * counting hits as open.
+ */
+inline void DensityStrategy::countRow( int lane, int row ) {
+    int line[MAX_BOARD_SIZE];
+    lineDensity(openRows[lane*MAX_BOARD_SIZE + row], boardSize, afloat[lane], line);
+    short* density = &rowDensity[lane*Cells + row*MAX_BOARD_SIZE];
+    for( int col=0; col<boardSize; col++ ) {
+	density[col] = line[col];
+    }
+}
+
+inline void DensityStrategy::countCol( int lane, int col ) {
+    int line[MAX_BOARD_SIZE];
+    lineDensity(openCols[lane*MAX_BOARD_SIZE + col], boardSize, afloat[lane], line);
+    short* density = &colDensity[lane*Cells + col];
+    for( int row=0; row<boardSize; row++ ) {
+	density[row*MAX_BOARD_SIZE] = line[row];
+    }
+}
+
+inline void DensityStrategy::onMiss( int lane, int row, int col ) {
+    openRows[lane*MAX_BOARD_SIZE + row] &= ~(1 << col);
+    openCols[lane*MAX_BOARD_SIZE + col] &= ~(1 << row);
+    if( ! recount[lane] ) {
+	countRow(lane, row);
+	countCol(lane, col);
+    }
+}
+
+inline void DensityStrategy::onSunk( int lane, Move ship ) {
+    bool horiz = getDirection(ship) == Horizontal;
+    for( int i=0; i<ship.length; i++ ) {
+	int row = horiz ? ship.row : ship.row + i;
+	int col = horiz ? ship.col + i : ship.col;
+	openRows[lane*MAX_BOARD_SIZE + row] &= ~(1 << col);
+	openCols[lane*MAX_BOARD_SIZE + col] &= ~(1 << row);
+    }
+    recount[lane] = true;
+}
+
+/**
+ * Shoots the densest cell, picking among ties at random as
+ * USSWhite::fireBestShot() does. While there are hits, only the cells
+ * reached by walking along them count.
+ */
+inline Move DensityStrategy::chooseShot( int lane ) {
+    if( recount[lane] ) {
+	for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	    afloat[lane].count[length] = max(0, fleet[lane].count[length] - sunkFleet[lane].count[length]);
+	}
+	for( int line=0; line<boardSize; line++ ) {
+	    countRow(lane, line);
+	    countCol(lane, line);
+	}
+	recount[lane] = false;
+    }
+    const short* rows = &rowDensity[lane*Cells];
+    const short* cols = &colDensity[lane*Cells];
+
+    CellMask candidates = 0;
+    CellMask hits = hitCells[lane];
+    while( hits ) {
+	int cell = firstCell(hits);
+	hits &= hits - 1;
+	int row, col;
+	for( int dir=0; dir<4; dir++ ) {
+	    int dRow = dir < 2 ? (dir == 0 ? -1 : 1) : 0;
+	    int dCol = dir < 2 ? 0 : (dir == 2 ? -1 : 1);
+	    if( firstUnshot(lane, cell / CellMaskStride, cell % CellMaskStride, dRow, dCol, row, col) ) {
+		candidates |= cellBit(row, col);
+	    }
+	}
+    }
+    if( candidates == 0 ) {
+	candidates = ~(shotCells[lane] | outside);
+	if( candidates == 0 ) return makeMove( SHOT, 0, 0 );
+    }
+
+    int highest = -1, ties = 0;
+    for( CellMask left = candidates; left; left &= left - 1 ) {
+	int cell = firstCell(left);
+	int value = rows[cell] + cols[cell];
+	if( value > highest ) {
+	    highest = value;
+	    ties = 0;
+	}
+	if( value == highest ) ties++;
+    }
+    int pick = random[lane].below(ties);
+    for( CellMask left = candidates; ; left &= left - 1 ) {
+	int cell = firstCell(left);
+	if( rows[cell] + cols[cell] == highest && pick-- == 0 ) {
+	    return makeMove( SHOT, cell / CellMaskStride, cell % CellMaskStride );
+	}
+    }
+}
+
+#endif
@@ -0,0 +1,232 @@
+/**
+ * BatchStrategy.h: players for the batch simulator (see BatchSimulator.h).
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A batch strategy plays many games at once, one per lane, and keeps its
+ * state as arrays indexed by lane (struct of arrays), so the simulator steps
+ * every lane through the same call over the same arrays. BatchStrategy holds
+ * what every strategy needs: each lane's random stream, the fleet dealt, the
+ * strategy's own ships and what its shots found, all as CellMasks. It calls
+ * the strategy through the template parameter (CRTP), so nothing is virtual
+ * and the calls inline into the simulator's loops.
+ *
+ * A strategy derives from BatchStrategy<itself> and defines, as public:
+ *	void startLane( int lane )		a new game; reset the lane's state
+ *	Move placeShip( int lane, int length )	as PlayerV3::nextPlacement()
+ *	Move chooseShot( int lane )		as PlayerV3::nextMove()
+ * and may define onMiss( lane, row, col ), onHit( lane, row, col ) and
+ * onSunk( lane, ship ), which are called after the masks are updated.
+ * Random numbers come from random[lane].
+ *
+ * Batch strategies never hear the opponent's shots and keep nothing from one
+ * game to the next, so the two sides of a game don't affect each other; that
+ * is what lets the simulator play them in lockstep. BatchPlayer runs a
+ * strategy as an ordinary PlayerV3, so the tester can play the same games
+ * and the two can be compared. Boards go up to MAX_BOARD_SIZE (one CellMask).
+ */
+
+#ifndef BATCHSTRATEGY_H		// Double inclusion protection
+#define BATCHSTRATEGY_H
+
+#include <vector>
+
+#include "PlayerV3.h"
+#include "Move.h"
+#include "GameRandom.h"
+#include "CellMask.h"
+#include "PlacementTable.h"
+#include "PlacementDensity.h"
+#include "defines.h"
+
+using namespace std;
+
+// Random spots placeRandomly() tries before taking the first that fits (as HuntPlayer).
+const int BatchPlacementTries = 100;
+
+template<class Strategy>
+class BatchStrategy {
+    public:
+	BatchStrategy( int boardSize, int lanes );
+
+	int lanes() const { return numLanes; }
+
+	// The simulator's side: the same calls AIContest makes, per lane.
+	void start( int lane, uint64_t key );
+	Move place( int lane, int length );
+	Move shoot( int lane );
+	void result( int lane, Move move );	// MISS, HIT, DUPLICATE_SHOT or INVALID_SHOT
+	void sunk( int lane, Move ship );	// After the HIT that sank it
+
+	// Hooks a strategy may hide.
+	void onMiss( int lane, int row, int col ) {}
+	void onHit( int lane, int row, int col ) {}
+	void onSunk( int lane, Move ship ) {}
+
+    protected:
+	/**
+	 * @brief Places a ship as HuntPlayer does: up to BatchPlacementTries
+	 * random spots, then the first spot that fits.
+	 */
+	Move placeRandomly( int lane, int length );
+	bool fits( int lane, int row, int col, int length, bool horiz );
+	bool unshot( int lane, int row, int col );
+	/**
+	 * @brief Walks from (row, col) in steps of (dRow, dCol) over hits to the
+	 * first unshot cell, much like USSWhite's branchOut(). False if a miss, a
+	 * sunk ship or the edge comes first.
+	 */
+	bool firstUnshot( int lane, int row, int col, int dRow, int dCol, int& toRow, int& toCol );
+
+	int boardSize;
+	int numLanes;
+	CellMask outside;		// Cells off the board
+	vector<GameRandom> random;
+	vector<FleetCounts> fleet;	// Ships dealt (both sides get the same)
+	vector<FleetCounts> sunkFleet;	// Enemy ships sunk so far
+	vector<CellMask> myShips;	// Our ships placed so far
+	vector<CellMask> shotCells;	// Our shots that have been answered
+	vector<CellMask> missCells;
+	vector<CellMask> hitCells;	// Hits on ships not known to be sunk
+	vector<CellMask> sunkCells;
+
+    private:
+	Strategy& strategy() { return static_cast<Strategy&>(*this); }
+};
+
+/**
+ * Runs a batch strategy as a PlayerV3 with one lane, for AIContest.
+ */
+template<class Strategy>
+class BatchPlayer : public PlayerV3 {
+    public:
+	BatchPlayer( int boardSize ) :PlayerV3(boardSize), strategy(boardSize, 1) { key = 0; }
+
+	void seedRandom( uint64_t key ) { this->key = key; }
+	void newRound() { strategy.start(0, key); }
+	Move nextPlacement( int length ) { return strategy.place(0, length); }
+	Move nextMove() { return strategy.shoot(0); }
+	void notify( Move move ) {
+	    // KILL cells come as one notifyKill(); nothing else is ours.
+	    if( move.type == MISS || move.type == HIT || move.type == DUPLICATE_SHOT || move.type == INVALID_SHOT ) {
+		strategy.result(0, move);
+	    }
+	}
+	void notifyKill( Move ship ) { strategy.sunk(0, ship); }
+
+    private:
+	Strategy strategy;
+	uint64_t key;
+};
+
+template<class Strategy>
+BatchStrategy<Strategy>::BatchStrategy( int boardSize, int lanes )
+    : random(lanes), fleet(lanes), sunkFleet(lanes), myShips(lanes), shotCells(lanes),
+      missCells(lanes), hitCells(lanes), sunkCells(lanes)
+{
+    this->boardSize = boardSize;
+    this->numLanes = lanes;
+    this->outside = outsideBoard(boardSize);
+}
+
+template<class Strategy>
+void BatchStrategy<Strategy>::start( int lane, uint64_t key ) {
+    random[lane].reset(key);
+    clearFleet(fleet[lane]);
+    clearFleet(sunkFleet[lane]);
+    myShips[lane] = shotCells[lane] = missCells[lane] = hitCells[lane] = sunkCells[lane] = 0;
+    strategy().startLane(lane);
+}
+
+template<class Strategy>
+Move BatchStrategy<Strategy>::place( int lane, int length ) {
+    if( length >= 1 && length <= MAX_SHIP_SIZE ) {
+	fleet[lane].count[length]++;
+    }
+    Move ship = strategy().placeShip(lane, length);
+    CellMask cells = placementMask(length, getDirection(ship) == Horizontal, ship.row, ship.col);
+    if( (cells & (myShips[lane] | outside)) == 0 ) {
+	myShips[lane] |= cells;
+    }
+    return ship;
+}
+
+template<class Strategy>
+Move BatchStrategy<Strategy>::shoot( int lane ) {
+    return strategy().chooseShot(lane);
+}
+
+template<class Strategy>
+void BatchStrategy<Strategy>::result( int lane, Move move ) {
+    if( move.type != MISS && move.type != HIT ) return;
+    CellMask cell = cellBit(move.row, move.col);
+    shotCells[lane] |= cell;
+    if( move.type == MISS ) {
+	missCells[lane] |= cell;
+	strategy().onMiss(lane, move.row, move.col);
+	return;
+    }
+    hitCells[lane] |= cell;
+    strategy().onHit(lane, move.row, move.col);
+}
+
+template<class Strategy>
+void BatchStrategy<Strategy>::sunk( int lane, Move ship ) {
+    CellMask cells = placementMask(ship.length, getDirection(ship) == Horizontal, ship.row, ship.col);
+    sunkCells[lane] |= cells;
+    shotCells[lane] |= cells;
+    hitCells[lane] &= ~cells;
+    if( ship.length >= 1 && ship.length <= MAX_SHIP_SIZE ) {
+	sunkFleet[lane].count[ship.length]++;
+    }
+    strategy().onSunk(lane, ship);
+}
+
+template<class Strategy>
+bool BatchStrategy<Strategy>::fits( int lane, int row, int col, int length, bool horiz ) {
+    return (placementMask(length, horiz, row, col) & (myShips[lane] | outside)) == 0;
+}
+
+template<class Strategy>
+bool BatchStrategy<Strategy>::unshot( int lane, int row, int col ) {
+    return row >= 0 && row < boardSize && col >= 0 && col < boardSize && ! hasCell(shotCells[lane], row, col);
+}
+
+template<class Strategy>
+bool BatchStrategy<Strategy>::firstUnshot( int lane, int row, int col, int dRow, int dCol, int& toRow, int& toCol ) {
+    for( row+=dRow, col+=dCol; row >= 0 && row < boardSize && col >= 0 && col < boardSize; row+=dRow, col+=dCol ) {
+	if( ! hasCell(shotCells[lane], row, col) ) {
+	    toRow = row;
+	    toCol = col;
+	    return true;
+	}
+	if( ! hasCell(hitCells[lane], row, col) ) break;
+    }
+    return false;
+}
+
+template<class Strategy>
+Move BatchStrategy<Strategy>::placeRandomly( int lane, int length ) {
+    GameRandom& rng = random[lane];
+    for( int i=0; i<BatchPlacementTries; i++ ) {
+	bool horiz = rng.below(2);
+	int row = rng.below(boardSize);
+	int col = rng.below(boardSize);
+	if( fits(lane, row, col, length, horiz) ) {
+	    return makeMove( PLACE_SHIP, row, col, horiz ? Horizontal : Vertical, length );
+	}
+    }
+    // Crowded board: take the first spot that fits.
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=0; col<boardSize; col++ ) {
+	    for( int horiz=0; horiz<2; horiz++ ) {
+		if( fits(lane, row, col, length, horiz) ) {
+		    return makeMove( PLACE_SHIP, row, col, horiz ? Horizontal : Vertical, length );
+		}
+	    }
+	}
+    }
+    return makeMove( PLACE_SHIP, 0, 0, Horizontal, length );
+}
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * Authors Stefan Brandle and Jonathan Geisler
+ * Date    November, 2004
+ * Implementation source file for BoardV3.
+ *
+ * Only the factory lives here; see SmallBoard.h and LargeBoard.cpp for the
+ * boards themselves.
+ */
+
+#ifndef BOARDV3_CPP
+#define BOARDV3_CPP
+
+#include "BoardV3.h"
+#include "SmallBoard.h"
+#include "LargeBoard.h"
+
+using namespace std;
+
+BoardV3* BoardV3::create( int width ) {
+    static_assert(MAX_BOARD_SIZE == 10, "give every size up to MAX_BOARD_SIZE a SmallBoard case");
+    switch( width ) {
+	case 1:  return new SmallBoard<1>();
+	case 2:  return new SmallBoard<2>();
+	case 3:  return new SmallBoard<3>();
+	case 4:  return new SmallBoard<4>();
+	case 5:  return new SmallBoard<5>();
+	case 6:  return new SmallBoard<6>();
+	case 7:  return new SmallBoard<7>();
+	case 8:  return new SmallBoard<8>();
+	case 9:  return new SmallBoard<9>();
+	case 10: return new SmallBoard<10>();
+	default: return new LargeBoard(width);
+    }
+}
+
+BoardV3::~BoardV3() {}
+
+#endif
@@ -4,6 +4,14 @@
  * Declaration source file for BoardV3.
  * Please type in your name[s] below:
  *
+ * BoardV3 is the interface; create() picks the storage for the board size:
+ *   - SmallBoard<Size> (SmallBoard.h) for sizes up to MAX_BOARD_SIZE: a
+ *     bitboard with the size fixed at compile time, so shots, sunk checks
+ *     and win checks are a few bit operations on constants.
+ *   - LargeBoard (LargeBoard.h) for anything bigger, up to
+ *     MAX_LARGE_BOARD_SIZE: one byte per cell in row-major order, with a
+ *     count of unshot cells per ship.
+ * Both behave the same as the original char-array board.
  */
 
 #ifndef BOARDV3_H
@@ -13,40 +21,46 @@
 
 using namespace std;
 
+/**
+ * Where a ship is: its top/left cell, length and direction.
+ */
+struct ShipLocation {
+    int row;
+    int col;
+    int length;			// 0 if there is no ship
+    Direction dir;		// Horizontal or Vertical
+    int shipId;			// Placement order, 0 = mark 'a'
+};
+
 class BoardV3 {
     public:
-	// Constructors and such
-	BoardV3( int width);		
-	BoardV3(const BoardV3& other);
-	void operator=(const BoardV3& other);
+	/**
+	 * @brief Makes an empty board of the given size (1 to MaxBoardSize).
+	 */
+	static BoardV3* create( int width );
+	virtual ~BoardV3();
+
+	/**
+	 * @brief Takes every ship and shot off the board, so it can be used for
+	 * another game without being made again.
+	 */
+	virtual void clear() = 0;
+
 	// General public access functions.
-	bool placeShip(int row, int col, int length, Direction dir);
-    	char getOpponentView(int row, int col);
-    	char getOwnerView(int row, int col);
-    	char getShipMark(int row, int col);
-    	char processShot(int row, int col);
-    	bool hasWon();
-
-        const static int MaxBoardSize = 10;     // Maximum board size.
-
-    private:
-	// Put prototypes for your private helper functions here.
-	void initialize(char board[MaxBoardSize][MaxBoardSize]);
-	bool positionOk(int row, int col, int length, bool horiz);
-	void markShip(int row, int col, int length, bool horiz);
-        bool isSunk(int row, int col);
-        void markSunk(int row, int col);
-
-	// Suggested data variables. Although you can ignore these, it
-	// is suggested that you use them. If you change the array definitions,
-	// you may have to change some of the prototypes or code that 
-	// you are given as part of your starter kit.
-	char shipBoard[MaxBoardSize][MaxBoardSize];    // Tracks the placed ships and shots
-	char shotBoard[MaxBoardSize][MaxBoardSize];    // Tracks where ships are through whole game
-	int boardSize;		    // Tracks how many rows/cols are actually being used.
-
-	// Put your private data variables here.
-	char shipMark;		    // Used to mark the ships on shipBoard
+	virtual bool placeShip(int row, int col, int length, Direction dir) = 0;
+    	virtual char getOpponentView(int row, int col) = 0;
+    	virtual char getOwnerView(int row, int col) = 0;
+    	virtual char getShipMark(int row, int col) = 0;
+    	virtual char processShot(int row, int col) = 0;
+    	virtual bool hasWon() = 0;
+	/**
+	 * @brief The ship covering row, col (length 0 if none), without looking
+	 * at the other cells.
+	 */
+	virtual ShipLocation getShip(int row, int col) = 0;
+
+        const static int MaxBoardSize = MAX_LARGE_BOARD_SIZE;   // Maximum board size.
+        const static int MaxShips = 26;                         // Ship marks 'a' to 'z'.
 };
 
 #endif	// End of multiple inclusion control.
@@ -0,0 +1,41 @@
+/**
+ * CellMask.h: a set of board cells packed into one 128-bit integer.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Cell (row, col) is bit row*MAX_BOARD_SIZE + col, so a MAX_BOARD_SIZE x
+ * MAX_BOARD_SIZE board (100 cells) fits in a single mask. Smaller boards use
+ * the same layout and simply leave the bits past boardSize in each row unused.
+ */
+
+#ifndef CELLMASK_H		// Double inclusion protection
+#define CELLMASK_H
+
+#include "defines.h"
+
+typedef unsigned __int128 CellMask;
+
+const int CellMaskStride = MAX_BOARD_SIZE;	// Bits per board row.
+
+constexpr CellMask cellBit( int row, int col ) {
+    return CellMask(1) << (row*CellMaskStride + col);
+}
+
+inline bool hasCell( CellMask mask, int row, int col ) {
+    return (mask >> (row*CellMaskStride + col)) & 1;
+}
+
+/**
+ * Bit number of the lowest cell in a non-empty mask (row*CellMaskStride + col).
+ */
+inline int firstCell( CellMask mask ) {
+    unsigned long long low = (unsigned long long)mask;
+    return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll((unsigned long long)(mask >> 64));
+}
+
+inline int cellCount( CellMask mask ) {
+    return __builtin_popcountll((unsigned long long)mask)
+         + __builtin_popcountll((unsigned long long)(mask >> 64));
+}
+
+#endif
@@ -0,0 +1,217 @@
+/**
+ * EnginePlayer.cpp: a player that runs in its own process (an engine).
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef ENGINEPLAYER_CPP	// Double inclusion protection
+#define ENGINEPLAYER_CPP
+
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "EnginePlayer.h"
+#include "defines.h"
+
+using namespace std;
+
+EnginePlayer::EnginePlayer( const string& command, int boardSize )
+    :PlayerV3(boardSize)
+{
+    this->command = command;
+    pid = -1;
+    fd = -1;
+    pending.reserve(4096);
+    seedKey = 0;
+    maxBoardSize = 0;
+    start();
+}
+
+EnginePlayer::~EnginePlayer() {
+    stop();
+}
+
+bool EnginePlayer::started() {
+    return fd >= 0;
+}
+
+const string& EnginePlayer::engineName() {
+    return name;
+}
+
+int EnginePlayer::engineMaxBoardSize() {
+    return maxBoardSize;
+}
+
+/**
+ * Starts the engine and says hello. The socket is close-on-exec, so engines
+ * started by other threads don't hold on to this one.
+ */
+bool EnginePlayer::start() {
+    int fds[2];
+    if( socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0 ) {
+	cerr << "Engine '" << command << "': cannot make a socket" << endl;
+	return false;
+    }
+    pid = fork();
+    if( pid == 0 ) {
+	// Only async-signal-safe calls between fork() and exec.
+	dup2(fds[1], STDIN_FILENO);
+	dup2(fds[1], STDOUT_FILENO);
+	execl("/bin/sh", "sh", "-c", command.c_str(), (char*)NULL);
+	_exit(127);
+    }
+    close(fds[1]);
+    if( pid < 0 ) {
+	close(fds[0]);
+	cerr << "Engine '" << command << "': cannot start a process" << endl;
+	return false;
+    }
+    fd = fds[0];
+    struct timeval timeout = { EngineTimeoutSeconds, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    unsigned char hello[3] = { (unsigned char)EngineProtocolVersion,
+			       (unsigned char)boardSize, (unsigned char)(boardSize >> 8) };
+    add(EngineHello, hello, sizeof(hello));
+    unsigned char info[4];
+    if( ! sendPending() || ! receive(info, sizeof(info)) || info[0] != EngineInfo ) {
+	fail("did not start");
+	return false;
+    }
+    maxBoardSize = info[1] | info[2] << 8;
+    name.resize(info[3]);
+    if( ! receive(&name[0], name.size()) ) {
+	fail("did not start");
+	return false;
+    }
+    return true;
+}
+
+/**
+ * Kills the engine; its player forfeits until the next round.
+ */
+void EnginePlayer::fail( const char* why ) {
+    if( fd < 0 ) return;
+    cerr << "Engine '" << command << "' " << why;
+    if( boardSize > 0 ) cerr << "; it forfeits the game";
+    cerr << endl;
+    stop();
+}
+
+void EnginePlayer::stop() {
+    if( fd >= 0 ) close(fd);
+    if( pid > 0 ) {
+	// Nothing is lost: an engine keeps nothing worth saving.
+	kill(pid, SIGKILL);
+	waitpid(pid, NULL, 0);
+    }
+    fd = -1;
+    pid = -1;
+    pending.clear();
+}
+
+void EnginePlayer::add( EngineMessage type, const void* data, size_t size ) {
+    if( fd < 0 ) return;
+    pending.push_back((unsigned char)type);
+    const unsigned char* bytes = (const unsigned char*)data;
+    pending.insert(pending.end(), bytes, bytes + size);
+}
+
+bool EnginePlayer::sendPending() {
+    size_t sent = 0;
+    while( sent < pending.size() ) {
+	ssize_t n = send(fd, &pending[sent], pending.size() - sent, MSG_NOSIGNAL);
+	if( n < 0 && errno == EINTR ) continue;
+	if( n <= 0 ) return false;
+	sent += n;
+    }
+    pending.clear();
+    return true;
+}
+
+bool EnginePlayer::receive( void* data, size_t size ) {
+    unsigned char* bytes = (unsigned char*)data;
+    size_t got = 0;
+    while( got < size ) {
+	ssize_t n = recv(fd, bytes + got, size - got, 0);
+	if( n < 0 && errno == EINTR ) continue;
+	if( n <= 0 ) return false;	// Closed, or timed out (EAGAIN)
+	got += n;
+    }
+    return true;
+}
+
+/**
+ * Sends everything held back plus a request, and waits for the Move that
+ * answers it.
+ */
+Move EnginePlayer::ask( EngineMessage type, const void* data, size_t size ) {
+    unsigned char reply[1 + sizeof(Move)];
+    add(type, data, size);
+    if( fd < 0 ) return makeMove(SHOT);
+    if( ! sendPending() ) {
+	fail("stopped reading");
+	return makeMove(SHOT);
+    }
+    if( ! receive(reply, sizeof(reply)) ) {
+	fail(errno == EAGAIN || errno == EWOULDBLOCK ? "timed out" : "stopped");
+	return makeMove(SHOT);
+    }
+    if( reply[0] != EngineMove ) {
+	fail("sent a bad message");
+	return makeMove(SHOT);
+    }
+    Move move;
+    memcpy(&move, reply + 1, sizeof(move));
+    return move;
+}
+
+void EnginePlayer::seedRandom( uint64_t key ) {
+    seedKey = key;
+    unsigned char bytes[8];
+    for( int i=0; i<8; i++ ) {
+	bytes[i] = (unsigned char)(key >> (8*i));
+    }
+    add(EngineSeed, bytes, sizeof(bytes));
+}
+
+void EnginePlayer::newRound() {
+    // A failed engine gets a fresh start, with this game's random stream.
+    if( fd < 0 && start() ) {
+	seedRandom(seedKey);
+    }
+    add(EngineNewRound);
+}
+
+Move EnginePlayer::nextMove() {
+    // A failed engine's shots are off the board.
+    return ask(EngineGetMove);
+}
+
+void EnginePlayer::notify( Move move ) {
+    add(EngineNotify, &move, sizeof(move));
+}
+
+void EnginePlayer::notifyKill( Move ship ) {
+    add(EngineNotifyKill, &ship, sizeof(ship));
+}
+
+Move EnginePlayer::nextPlacement( int length ) {
+    unsigned char shipLength = length;
+    Move placement = ask(EnginePlace, &shipLength, 1);
+    if( fd < 0 ) {
+	// A failed engine places its ships off the board.
+	placement = makeMove(PLACE_SHIP, -1, -1, Horizontal, length);
+    }
+    return placement;
+}
+
+#endif
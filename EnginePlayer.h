@@ -0,0 +1,78 @@
+/**
+ * EnginePlayer.h: a player that runs in its own process (an engine).
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The referee sees a PlayerV3; behind it is an engine program started with
+ * /bin/sh -c command and spoken to over a Unix socket (see
+ * EngineProtocol.h). Updates are held back and go out with the next
+ * request, so a move is one round trip.
+ *
+ * An engine that crashes, closes the socket, sends garbage or takes longer
+ * than EngineTimeoutSeconds to answer is killed. Its player forfeits the
+ * rest of the game: placements that don't fit, shots off the board. The
+ * next round starts a fresh engine, so one bad game costs only that game
+ * and never the contest.
+ */
+
+#ifndef ENGINEPLAYER_H		// Double inclusion protection
+#define ENGINEPLAYER_H
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "PlayerV3.h"
+#include "EngineProtocol.h"
+
+using namespace std;
+
+class EnginePlayer : public PlayerV3 {
+    public:
+	/**
+	 * Starts the engine for a board of boardSize. A boardSize of 0 only
+	 * asks the engine who it is (see started()).
+	 */
+	EnginePlayer( const string& command, int boardSize );
+	~EnginePlayer();
+
+	void newRound();
+	Move nextMove();
+	void notify( Move move );
+	void notifyKill( Move ship );
+	Move nextPlacement( int length );
+	void seedRandom( uint64_t key );
+
+	/**
+	 * @brief Whether the engine is running; if so, engineName() and
+	 * engineMaxBoardSize() are what it said about itself.
+	 */
+	bool started();
+	const string& engineName();
+	int engineMaxBoardSize();
+
+	static const int EngineTimeoutSeconds = 10;
+
+    private:
+	bool start();
+	void fail( const char* why );
+	void stop();
+	void add( EngineMessage type, const void* data = NULL, size_t size = 0 );
+	bool sendPending();
+	bool receive( void* data, size_t size );
+	Move ask( EngineMessage type, const void* data = NULL, size_t size = 0 );
+
+	string command;
+	pid_t pid;
+	int fd;			// Our end of the socket; -1 when not running
+	vector<unsigned char> pending;	// Messages not sent yet
+	uint64_t seedKey;
+	string name;
+	int maxBoardSize;
+
+	// Not copyable.
+	EnginePlayer( const EnginePlayer& );
+	void operator=( const EnginePlayer& );
+};
+
+#endif
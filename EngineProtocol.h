@@ -0,0 +1,59 @@
+/**
+ * EngineProtocol.h: how the referee talks to a player in another process.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * An engine is a program that hosts one player and reads requests on its
+ * standard input and answers on its standard output (see engine.cpp);
+ * EnginePlayer.h is the referee's side. Both ends are the same build on
+ * the same machine, so messages are raw bytes: a one-byte EngineMessage
+ * code, then its fields. Moves go as the 8-byte Move struct and numbers
+ * as little-endian bytes.
+ *
+ * From the referee:
+ *   EngineHello	version (1 byte), board size (2 bytes). The engine answers
+ *			EngineInfo and, if the board size isn't 0, makes its
+ *			player for that board.
+ *   EngineSeed		the player's random stream key (8 bytes, see
+ *			PlayerV3::seedRandom)
+ *   EngineNewRound
+ *   EngineNotify	a Move (PlayerV3::notify)
+ *   EngineNotifyKill	a Move (PlayerV3::notifyKill)
+ *   EnginePlace	ship length (1 byte); the engine answers EngineMove
+ *   EngineGetMove	the engine answers EngineMove
+ *
+ * From the engine:
+ *   EngineInfo		largest board (2 bytes), name length (1 byte), name
+ *   EngineMove		a Move
+ *
+ * Only EngineHello, EnginePlace and EngineGetMove are answered. The
+ * referee holds everything else until it needs an answer and sends it
+ * in the same write as the request, so a move costs one write and one
+ * read at each end however many updates came before it.
+ */
+
+#ifndef ENGINEPROTOCOL_H	// Double inclusion protection
+#define ENGINEPROTOCOL_H
+
+#include "Move.h"
+
+const int EngineProtocolVersion = 1;
+
+enum EngineMessage {
+    EngineHello = 'H',
+    EngineSeed = 'S',
+    EngineNewRound = 'N',
+    EngineNotify = 'U',
+    EngineNotifyKill = 'K',
+    EnginePlace = 'P',
+    EngineGetMove = 'G',
+    EngineInfo = 'I',
+    EngineMove = 'M'
+};
+
+static_assert( sizeof(Move) == 8, "EngineProtocol sends Moves as 8 bytes" );
+
+// Longest message: EngineInfo with a 255-byte name.
+const int EngineMaxMessage = 1 + 2 + 1 + 255;
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * GameRandom.h: counter-based random numbers, one stream per game and player.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Value i of a stream is a fixed function of the stream's key and i (the
+ * splitmix64 finalizer of key + (i+1)*gamma), so a stream is just a key and a
+ * counter: it can be restarted anywhere, and streams with different keys
+ * don't affect each other.
+ *
+ * Every game has a seed made from (tournament seed, pairing, round) by
+ * gameSeed(). AIContest gives the referee, each player and the C library
+ * rand() (for the provided binaries, see ThreadRandom.h) their own stream
+ * keyed from it. A game's random choices depend on nothing else, so it
+ * plays the same alone, in a batch or on any thread. Players that learn
+ * across rounds still need the earlier rounds replayed first.
+ */
+
+#ifndef GAMERANDOM_H		// Double inclusion protection
+#define GAMERANDOM_H
+
+#include <cstdint>
+
+#include "ThreadRandom.h"
+
+// MoveThreadStream is rand() on the thread that asks player 2 for its moves
+// when they are computed alongside player 1's updates (AIContest::setPipelined()).
+enum GameStream { RefereeStream=0, Player1Stream, Player2Stream, LibraryStream, MoveThreadStream };
+
+/**
+ * @brief The seed of one game of a tournament.
+ */
+inline uint64_t gameSeed( uint64_t seed, uint64_t pairing, uint64_t round ) {
+    return threadRandom::deriveSeed(seed, pairing, round);
+}
+
+/**
+ * @brief The key of one of a game's streams.
+ */
+inline uint64_t streamKey( uint64_t gameSeed, GameStream stream ) {
+    return threadRandom::deriveSeed(gameSeed, stream);
+}
+
+class GameRandom {
+    public:
+	GameRandom( uint64_t key = 0 ) {
+	    reset(key);
+	}
+
+	/**
+	 * @brief Restarts the stream from its first value with a new key.
+	 */
+	void reset( uint64_t key ) {
+	    this->key = key;
+	    counter = 0;
+	}
+
+	/**
+	 * @brief Value number index of the stream, without moving along it.
+	 */
+	uint64_t at( uint64_t index ) const {
+	    uint64_t z = key + (index + 1) * 0x9e3779b97f4a7c15ULL;
+	    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	    return z ^ (z >> 31);
+	}
+
+	uint64_t next() {
+	    return at(counter++);
+	}
+
+	/**
+	 * @brief A number from 0 to n-1 (n > 0).
+	 */
+	int below( int n ) {
+	    return (int)(((next() >> 32) * (uint64_t)n) >> 32);
+	}
+
+	/**
+	 * @brief How many values have been taken since reset().
+	 */
+	uint64_t position() const {
+	    return counter;
+	}
+
+    private:
+	uint64_t key;
+	uint64_t counter;
+};
+
+#endif
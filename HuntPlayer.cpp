@@ -0,0 +1,139 @@
+/**
+ * HuntPlayer.cpp: a hunt/target player for boards of any size.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef HUNTPLAYER_CPP		// Double inclusion protection
+#define HUNTPLAYER_CPP
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "HuntPlayer.h"
+
+// Random spots to try before a ship is placed at the first spot that fits.
+const int RandomPlacementTries = 100;
+
+HuntPlayer::HuntPlayer( int boardSize )
+    : PlayerV3(boardSize),
+      shots(boardSize*boardSize, WATER),
+      myShips(boardSize*boardSize, false)
+{
+    huntCells.reserve(boardSize*boardSize);
+    targets.reserve(4*MAX_SHIP_SIZE);
+    nextHunt = 0;
+    nextScan = 0;
+}
+
+HuntPlayer::~HuntPlayer() {}
+
+void HuntPlayer::newRound() {
+    shots.assign(shots.size(), WATER);
+    myShips.assign(myShips.size(), false);
+    targets.clear();
+    nextScan = 0;
+
+    // Every MIN_SHIP_SIZE'th diagonal: any ship at least that long crosses one.
+    int offset = gameRandom.below(MIN_SHIP_SIZE);
+    huntCells.clear();
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=0; col<boardSize; col++ ) {
+	    if( (row + col) % MIN_SHIP_SIZE == offset ) {
+		huntCells.push_back(row*boardSize + col);
+	    }
+	}
+    }
+    for( int i=(int)huntCells.size()-1; i>0; i-- ) {
+	swap(huntCells[i], huntCells[gameRandom.below(i+1)]);
+    }
+    nextHunt = 0;
+}
+
+bool HuntPlayer::fits( int row, int col, int length, bool horiz ) {
+    if( (horiz ? col : row) + length > boardSize ) {
+	return false;
+    }
+    for( int i=0; i<length; i++ ) {
+	if( myShips[(horiz ? row : row+i)*boardSize + (horiz ? col+i : col)] ) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+Move HuntPlayer::placeAt( int row, int col, int length, bool horiz ) {
+    for( int i=0; i<length; i++ ) {
+	myShips[(horiz ? row : row+i)*boardSize + (horiz ? col+i : col)] = true;
+    }
+    return makeMove( PLACE_SHIP, row, col, horiz ? Horizontal : Vertical, length );
+}
+
+Move HuntPlayer::nextPlacement( int length ) {
+    for( int i=0; i<RandomPlacementTries; i++ ) {
+	bool horiz = gameRandom.below(2);
+	int row = gameRandom.below(boardSize);
+	int col = gameRandom.below(boardSize);
+	if( fits(row, col, length, horiz) ) {
+	    return placeAt(row, col, length, horiz);
+	}
+    }
+    // Crowded board: take the first spot that fits.
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=0; col<boardSize; col++ ) {
+	    for( int horiz=0; horiz<2; horiz++ ) {
+		if( fits(row, col, length, horiz) ) {
+		    return placeAt(row, col, length, horiz);
+		}
+	    }
+	}
+    }
+    return makeMove( PLACE_SHIP, 0, 0, Horizontal, length );
+}
+
+Move HuntPlayer::nextMove() {
+    while( ! targets.empty() ) {
+	int cell = targets.back();
+	targets.pop_back();
+	if( shots[cell] == WATER ) {
+	    return makeMove( SHOT, cell / boardSize, cell % boardSize );
+	}
+    }
+    while( nextHunt < huntCells.size() ) {
+	int cell = huntCells[nextHunt++];
+	if( shots[cell] == WATER ) {
+	    return makeMove( SHOT, cell / boardSize, cell % boardSize );
+	}
+    }
+    while( nextScan < boardSize*boardSize && shots[nextScan] != WATER ) {
+	nextScan++;
+    }
+    int cell = nextScan < boardSize*boardSize ? nextScan : 0;
+    return makeMove( SHOT, cell / boardSize, cell % boardSize );
+}
+
+void HuntPlayer::addTarget( int row, int col ) {
+    if( row >= 0 && row < boardSize && col >= 0 && col < boardSize && shots[row*boardSize + col] == WATER ) {
+	targets.push_back(row*boardSize + col);
+    }
+}
+
+void HuntPlayer::notify( Move move ) {
+    switch( move.type ) {
+	case HIT:
+	    shots[move.row*boardSize + move.col] = HIT;
+	    addTarget(move.row-1, move.col);
+	    addTarget(move.row+1, move.col);
+	    addTarget(move.row, move.col-1);
+	    addTarget(move.row, move.col+1);
+	    break;
+	case KILL:
+	case MISS:
+	    shots[move.row*boardSize + move.col] = move.type;
+	    break;
+	default:
+	    break;
+    }
+}
+
+#endif
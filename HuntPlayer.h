@@ -0,0 +1,48 @@
+/**
+ * HuntPlayer.h: a hunt/target player for boards of any size.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The other players keep MAX_BOARD_SIZE x MAX_BOARD_SIZE arrays, so they
+ * only play boards up to that size. HuntPlayer sizes everything from the
+ * board size it is given, which makes it the baseline on large boards.
+ *
+ * It hunts on a diagonal grid that every ship of MIN_SHIP_SIZE or more must
+ * cross, in a random order, and after a hit shoots the neighbours of every
+ * hit before going back to hunting. Ships are placed at random.
+ */
+
+#ifndef HUNTPLAYER_H		// Double inclusion protection
+#define HUNTPLAYER_H
+
+#include <vector>
+
+#include "PlayerV3.h"
+#include "Move.h"
+#include "defines.h"
+
+using namespace std;
+
+class HuntPlayer : public PlayerV3 {
+    public:
+	HuntPlayer( int boardSize );
+	~HuntPlayer();
+	void newRound();
+	Move nextPlacement( int length );
+	Move nextMove();
+	void notify( Move move );
+
+    private:
+	bool fits( int row, int col, int length, bool horiz );
+	Move placeAt( int row, int col, int length, bool horiz );
+	void addTarget( int row, int col );
+
+	vector<char> shots;	// Our shots: WATER, MISS, HIT or KILL, row-major.
+	vector<char> myShips;	// Cells our ships cover this round.
+	vector<int> huntCells;	// Cells of the hunting grid, shuffled each round.
+	size_t nextHunt;	// Next huntCells entry to try.
+	vector<int> targets;	// Cells next to hits, still to shoot.
+	int nextScan;		// Where to look for water once the grid is used up.
+};
+
+#endif
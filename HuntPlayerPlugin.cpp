@@ -0,0 +1,13 @@
+/**
+ * HuntPlayerPlugin.cpp: HuntPlayer built as a plugin, HuntPlayer.so.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The drivers have HuntPlayer built in as well; the plugin lets the bench
+ * time the same player both ways (./bench -l HuntPlayer.so).
+ */
+
+#include "HuntPlayer.h"
+#include "PlayerPlugin.h"
+
+PLAYER_PLUGIN( HuntPlayer, "Hunt Player plugin", MAX_LARGE_BOARD_SIZE, true )
@@ -0,0 +1,143 @@
+/**
+ * LargeBoard.cpp: BoardV3 for boards bigger than MAX_BOARD_SIZE.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef LARGEBOARD_CPP		// Double inclusion protection
+#define LARGEBOARD_CPP
+
+#include <algorithm>
+#include <iostream>
+
+#include "LargeBoard.h"
+
+using namespace std;
+
+LargeBoard::LargeBoard( int width )
+    : cells(width*width, 0)
+{
+    boardSize = width;
+    numShips = 0;
+    shipsAfloat = 0;
+}
+
+void LargeBoard::clear() {
+    fill(cells.begin(), cells.end(), 0);
+    numShips = 0;
+    shipsAfloat = 0;
+}
+
+unsigned char& LargeBoard::cellAt( int row, int col ) {
+    return cells[row*boardSize + col];
+}
+
+/**
+ * Places a ship with its top/left end at row, col. Any direction other than
+ * Horizontal is treated as Vertical.
+ * @return false if the ship would leave the board or overlap another ship.
+ */
+bool LargeBoard::placeShip( int row, int col, int length, Direction dir ) {
+    bool horiz = dir == Horizontal;
+    if( ! positionOk(row, col, length, horiz) ) {
+	return false;
+    }
+    for( int i=0; i<length; i++ ) {
+	cellAt(horiz ? row : row+i, horiz ? col+i : col) = ShipFlag | numShips;
+    }
+    ShipLocation location = { row, col, length, horiz ? Horizontal : Vertical, numShips };
+    ships[numShips] = location;
+    unshotCells[numShips++] = length;
+    if( length > 0 ) {		// An empty ship has nothing to sink (as the original)
+	shipsAfloat++;
+    }
+    return true;
+}
+
+bool LargeBoard::positionOk( int row, int col, int length, bool horiz ) {
+    if( horiz ) {
+	if( row < 0 || row >= boardSize || col < 0 || col+length-1 >= boardSize ) {
+	    cerr << "positionOk: horizontal position invalid" << endl;
+	    return false;
+	}
+    } else {
+	if( col < 0 || col >= boardSize || row < 0 || row+length-1 >= boardSize ) {
+	    cerr << "positionOk: vertical position invalid" << endl;
+	    return false;
+	}
+    }
+    if( numShips >= MaxShips ) {
+	cerr << "positionOk: too many ships" << endl;
+	return false;
+    }
+
+    for( int i=0; i<length; i++ ) {
+	int r = horiz ? row : row+i;
+	int c = horiz ? col+i : col;
+	if( cellAt(r, c) & ShipFlag ) {
+	    cerr << "positionOk: horizontal collision at row=" << r << ", col=" << c << endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+char LargeBoard::getOpponentView( int row, int col ) {
+    unsigned char cell = cellAt(row, col);
+    if( ! (cell & ShotFlag) ) return WATER;
+    if( ! (cell & ShipFlag) ) return MISS;
+    return unshotCells[cell & ShipNumberBits] == 0 ? KILL : HIT;
+}
+
+char LargeBoard::getOwnerView( int row, int col ) {
+    unsigned char cell = cellAt(row, col);
+    if( (cell & ShipFlag) && ! (cell & ShotFlag) ) {
+	return getShipMark(row, col);
+    }
+    return getOpponentView(row, col);
+}
+
+char LargeBoard::getShipMark( int row, int col ) {
+    unsigned char cell = cellAt(row, col);
+    if( ! (cell & ShipFlag) ) return WATER;
+    return 'a' + (cell & ShipNumberBits);
+}
+
+/**
+ * Shoots at row, col.
+ * @return MISS, HIT, KILL (the shot sank the ship), DUPLICATE_SHOT, or
+ * INVALID_SHOT for a shot off the board.
+ */
+char LargeBoard::processShot( int row, int col ) {
+    if( row < 0 || row >= boardSize || col < 0 || col >= boardSize ) {
+	return INVALID_SHOT;
+    }
+    unsigned char& cell = cellAt(row, col);
+    if( cell & ShotFlag ) {
+	return DUPLICATE_SHOT;
+    }
+    cell |= ShotFlag;
+    if( ! (cell & ShipFlag) ) {
+	return MISS;
+    }
+    if( --unshotCells[cell & ShipNumberBits] > 0 ) {
+	return HIT;
+    }
+    shipsAfloat--;
+    return KILL;
+}
+
+bool LargeBoard::hasWon() {
+    return shipsAfloat == 0;
+}
+
+ShipLocation LargeBoard::getShip( int row, int col ) {
+    unsigned char cell = cellAt(row, col);
+    if( ! (cell & ShipFlag) ) {
+	ShipLocation none = { row, col, 0, None, -1 };
+	return none;
+    }
+    return ships[cell & ShipNumberBits];
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * LargeBoard.h: BoardV3 for boards bigger than MAX_BOARD_SIZE.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Each cell is one byte, rows stored one after another, holding the cell's
+ * ship number and whether it has been shot, so a shot reads and writes a
+ * single byte wherever it lands. Each ship keeps a count of its unshot cells
+ * and the board a count of ships still afloat, so sunk and win checks don't
+ * look at the cells at all. A 200x200 board is 40KB.
+ */
+
+#ifndef LARGEBOARD_H		// Double inclusion protection
+#define LARGEBOARD_H
+
+#include <vector>
+
+#include "BoardV3.h"
+
+using namespace std;
+
+class LargeBoard : public BoardV3 {
+    public:
+	LargeBoard( int width );
+
+	void clear();
+	bool placeShip(int row, int col, int length, Direction dir);
+	char getOpponentView(int row, int col);
+	char getOwnerView(int row, int col);
+	char getShipMark(int row, int col);
+	char processShot(int row, int col);
+	bool hasWon();
+	ShipLocation getShip(int row, int col);
+
+    private:
+	bool positionOk(int row, int col, int length, bool horiz);
+	unsigned char& cellAt(int row, int col);
+
+	// Cell byte: the ship number in the low bits, plus these flags.
+	const static unsigned char ShipFlag = 0x40;
+	const static unsigned char ShotFlag = 0x80;
+	const static unsigned char ShipNumberBits = 0x3f;
+
+	vector<unsigned char> cells;	// boardSize*boardSize, row-major.
+	int unshotCells[MaxShips];	// Cells of each ship not yet shot.
+	ShipLocation ships[MaxShips];	// Where each ship is, in placement order.
+	int numShips;
+	int shipsAfloat;
+	int boardSize;
+};
+
+#endif
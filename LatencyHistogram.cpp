@@ -0,0 +1,105 @@
+/**
+ * LatencyHistogram.cpp: a fixed-size histogram of call latencies.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef LATENCYHISTOGRAM_CPP	// Double inclusion protection
+#define LATENCYHISTOGRAM_CPP
+
+#include <sstream>
+
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+LatencyHistogram::LatencyHistogram() {
+    for( int i=0; i<NumBuckets; i++ ) {
+	counts[i] = 0;
+    }
+    total = 0;
+    largest = 0;
+}
+
+/**
+ * Values below ExactBelow have a bucket each. Above that, a value's top
+ * SubBucketBits+1 bits pick its bucket: the highest bit says which power of
+ * two, the bits under it which sixteenth of it.
+ */
+int LatencyHistogram::bucketOf( long long nanoseconds ) {
+    if( nanoseconds < ExactBelow ) return nanoseconds < 0 ? 0 : (int)nanoseconds;
+    if( nanoseconds >> MaxBits ) nanoseconds = (1LL << MaxBits) - 1;
+    int highBit = 63 - __builtin_clzll(nanoseconds);
+    int shift = highBit - SubBucketBits;
+    return ExactBelow + (shift-1) * (1 << SubBucketBits) + (int)(nanoseconds >> shift) - (1 << SubBucketBits);
+}
+
+long long LatencyHistogram::bucketMiddle( int bucket ) {
+    if( bucket < ExactBelow ) return bucket;
+    int shift = (bucket - ExactBelow) / (1 << SubBucketBits) + 1;
+    long long first = (long long)((bucket - ExactBelow) % (1 << SubBucketBits) + (1 << SubBucketBits)) << shift;
+    return first + (1LL << shift) / 2;
+}
+
+void LatencyHistogram::record( long long nanoseconds ) {
+    counts[bucketOf(nanoseconds)]++;
+    total++;
+    if( nanoseconds > largest ) largest = nanoseconds;
+}
+
+void LatencyHistogram::add( const LatencyHistogram& other ) {
+    for( int i=0; i<NumBuckets; i++ ) {
+	counts[i] += other.counts[i];
+    }
+    total += other.total;
+    if( other.largest > largest ) largest = other.largest;
+}
+
+long long LatencyHistogram::count() const {
+    return total;
+}
+
+long long LatencyHistogram::max() const {
+    return largest;
+}
+
+long long LatencyHistogram::percentile( double percent ) const {
+    if( total == 0 ) return 0;
+    // The sample that percentile falls on, counting from 1.
+    long long rank = (long long)(percent / 100.0 * (total - 1) + 0.5) + 1;
+    long long seen = 0;
+    for( int i=0; i<NumBuckets; i++ ) {
+	seen += counts[i];
+	if( seen >= rank ) {
+	    long long middle = bucketMiddle(i);
+	    return middle < largest ? middle : largest;
+	}
+    }
+    return largest;
+}
+
+string LatencyHistogram::toJson() const {
+    ostringstream out;
+    out << "{\"count\":" << count() << ",\"p50\":" << percentile(50)
+	<< ",\"p99\":" << percentile(99) << ",\"max\":" << max() << "}";
+    return out.str();
+}
+
+static void writeTime( ostream& out, long long nanoseconds ) {
+    if( nanoseconds < 10000 ) out << nanoseconds << " ns";
+    else if( nanoseconds < 10000000 ) out << nanoseconds / 1000 << " us";
+    else out << nanoseconds / 1000000 << " ms";
+}
+
+string LatencyHistogram::toText() const {
+    ostringstream out;
+    out << "p50 ";
+    writeTime(out, percentile(50));
+    out << ", p99 ";
+    writeTime(out, percentile(99));
+    out << ", max ";
+    writeTime(out, max());
+    return out.str();
+}
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * LatencyHistogram.h: a fixed-size histogram of call latencies.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Buckets are log-linear, as in an HDR histogram: exact below 32 ns, then 16
+ * buckets per power of two, so any value is reported to within about 6%.
+ * Recording is a few shifts and an increment, nothing is allocated, and two
+ * histograms add up bucket by bucket, so each thread can keep its own and
+ * merge them at the end. Only the maximum is kept exactly.
+ */
+
+#ifndef LATENCYHISTOGRAM_H	// Double inclusion protection
+#define LATENCYHISTOGRAM_H
+
+#include <string>
+
+using namespace std;
+
+class LatencyHistogram {
+    public:
+	LatencyHistogram();
+
+	void record( long long nanoseconds );
+	void add( const LatencyHistogram& other );
+
+	long long count() const;
+	long long max() const;
+	/**
+	 * @brief The given percentile (0-100), in nanoseconds: the middle of the
+	 * bucket it falls in.
+	 */
+	long long percentile( double percent ) const;
+
+	/**
+	 * @brief Writes {"count":..,"p50":..,"p99":..,"max":..} in nanoseconds.
+	 */
+	string toJson() const;
+
+	/**
+	 * @brief Writes "p50 .. p99 .. max .." with units, e.g. "p50 55 ns".
+	 */
+	string toText() const;
+
+    private:
+	static const int SubBucketBits = 4;
+	static const int ExactBelow = 2 << SubBucketBits;	// 32 ns
+	static const int MaxBits = 42;				// Over an hour
+	static const int NumBuckets = ExactBelow + (MaxBits - SubBucketBits) * (1 << SubBucketBits);
+
+	static int bucketOf( long long nanoseconds );
+	static long long bucketMiddle( int bucket );
+
+	long long counts[NumBuckets];
+	long long total;
+	long long largest;
+};
+
+#endif
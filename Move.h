@@ -0,0 +1,67 @@
+/**
+ * Move.h: a plain-data move/result record for the shot and update hot path.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A Move holds the same information as a Message except for the string, so
+ * it is eight bytes, copied by value and never touches the heap. Players that
+ * still speak Message are converted at the edge with toMove()/toMessage().
+ */
+
+#ifndef MOVE_H			// Double inclusion protection
+#define MOVE_H
+
+#include "defines.h"
+#include "Message.h"
+
+using namespace std;
+
+struct Move {
+    char type;			// SHOT, MISS, HIT, KILL, OPPONENT_SHOT, PLACE_SHIP, WIN, ...
+    signed char dir;		// Direction, for PLACE_SHIP
+    signed char length;		// Ship length, for PLACE_SHIP
+    signed char shipId;		// Ship a KILL belongs to (0 = 'a'), -1 if not known
+    short row;
+    short col;
+};
+
+inline Move makeMove( char type, int row = -1, int col = -1, Direction dir = None, int length = 0, int shipId = -1 ) {
+    Move move;
+    move.type = type;
+    move.dir = dir;
+    move.length = length;
+    move.shipId = shipId;
+    move.row = row;
+    move.col = col;
+    return move;
+}
+
+inline Direction getDirection( const Move& move ) {
+    return Direction(move.dir);
+}
+
+/**
+ * @brief Cell i (0 = top/left) of a sunk ship, as a per-cell KILL Move.
+ * @param ship Move with type KILL, the ship's top/left row, col, its dir,
+ * length and shipId (see PlayerV3::notifyKill).
+ */
+inline Move killCell( const Move& ship, int i ) {
+    bool horiz = ship.dir == Horizontal;
+    return makeMove( KILL, ship.row + (horiz ? 0 : i), ship.col + (horiz ? i : 0), None, 0, ship.shipId );
+}
+
+/**
+ * @brief Converts a Message from a PlayerV2 player. The string is dropped.
+ */
+inline Move toMove( Message& msg ) {
+    return makeMove( msg.getMessageType(), msg.getRow(), msg.getCol(), msg.getDirection(), msg.getLength() );
+}
+
+/**
+ * @brief Converts a Move for a PlayerV2 player. The string is left empty.
+ */
+inline Message toMessage( const Move& move ) {
+    return Message( move.type, move.row, move.col, "", getDirection(move), move.length );
+}
+
+#endif
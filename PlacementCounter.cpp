@@ -0,0 +1,217 @@
+/**
+ * PlacementCounter.cpp: exact hit probabilities by counting fleet configurations.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef PLACEMENTCOUNTER_CPP	// Double inclusion protection
+#define PLACEMENTCOUNTER_CPP
+
+#include <algorithm>
+#include <cstdint>
+
+#include "PlacementCounter.h"
+#include "PlacementTable.h"
+
+PlacementCounter::PlacementCounter( int maxStates ) {
+    this->maxStates = maxStates;
+    int size = 1;
+    while( size < 2*maxStates ) size *= 2;
+    table.resize(size);
+    for( size_t i=0; i<table.size(); i++ ) {
+	table[i].stamp = 0;
+    }
+    // States still being counted when the limit is reached can each add one more.
+    used.reserve(maxStates + MaxFleetShips);
+    for( int i=0; i<MaxFleetShips; i++ ) {
+	placements[i].reserve(2*MAX_BOARD_SIZE*MAX_BOARD_SIZE);
+    }
+    currentStamp = 0;
+    outOfStates = false;
+    tried = 0;
+    numShips = 0;
+    hits = 0;
+}
+
+int PlacementCounter::statesUsed() {
+    return used.size();
+}
+
+long PlacementCounter::placementsTried() {
+    return tried;
+}
+
+/**
+ * Lists every placing of each ship in shipLengths that misses the misses and
+ * sunk ships, and the cells each ship onward could cover.
+ */
+void PlacementCounter::findPlacements( const ShotEvidence& evidence ) {
+    CellMask blocked = evidence.misses | evidence.sunk | outsideBoard(evidence.boardSize);
+    for( int i=0; i<numShips; i++ ) {
+	placements[i].clear();
+	for( int horiz=0; horiz<2; horiz++ ) {
+	    for( int row=0; row<evidence.boardSize; row++ ) {
+		for( int col=0; col<evidence.boardSize; col++ ) {
+		    CellMask ship = placementMask(shipLengths[i], horiz, row, col);
+		    if( (ship & blocked) == 0 ) {
+			placements[i].push_back(ship);
+		    }
+		}
+	    }
+	}
+    }
+
+    reachable[numShips] = 0;
+    for( int i=numShips-1; i>=0; i-- ) {
+	reachable[i] = reachable[i+1];
+	for( size_t p=0; p<placements[i].size(); p++ ) {
+	    reachable[i] |= placements[i][p];
+	}
+    }
+}
+
+/**
+ * Whether ships depth.. can still cover every hit that taken leaves uncovered.
+ */
+bool PlacementCounter::allowed( int depth, CellMask taken ) {
+    return (hits & ~taken & ~reachable[depth]) == 0;
+}
+
+int PlacementCounter::findState( int depth, CellMask cells ) {
+    uint64_t low = (uint64_t)cells, high = (uint64_t)(cells >> 64);
+    uint64_t hash = (low ^ (high * 0x9e3779b97f4a7c15ULL) ^ (uint64_t)depth) * 0xbf58476d1ce4e5b9ULL;
+    size_t mask = table.size() - 1;
+    size_t slot = (hash ^ (hash >> 29)) & mask;
+    while( table[slot].stamp == currentStamp && (table[slot].depth != depth || table[slot].cells != cells) ) {
+	slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Ways to place ships depth.. given the cells already taken (only the ones
+ * those ships could use). Placings are counted per ship, so ships of the same
+ * length in swapped places count separately; every configuration is counted
+ * the same number of times, which the chances do not notice.
+ */
+double PlacementCounter::waysFrom( int depth, CellMask cells ) {
+    if( depth == numShips ) {
+	return 1;
+    }
+    int slot = findState(depth, cells);
+    if( table[slot].stamp == currentStamp ) {
+	return table[slot].ways;
+    }
+    if( (int)used.size() >= maxStates ) {
+	outOfStates = true;
+	return 0;
+    }
+
+    double ways = 0;
+    const vector<CellMask>& ships = placements[depth];
+    tried += ships.size();
+    for( size_t p=0; p<ships.size() && ! outOfStates; p++ ) {
+	if( ships[p] & cells ) continue;
+	CellMask taken = cells | ships[p];
+	if( allowed(depth+1, taken) ) {
+	    // Only exact because the ships are longest first (see count()).
+	    ways += waysFrom(depth+1, taken & reachable[depth+1]);
+	}
+    }
+    if( outOfStates ) {
+	return 0;
+    }
+
+    // The calls above may have filled the slot we found, so look again.
+    slot = findState(depth, cells);
+    table[slot].cells = cells;
+    table[slot].depth = depth;
+    table[slot].ways = ways;
+    table[slot].reach = 0;
+    table[slot].stamp = currentStamp;
+    used.push_back(slot);
+    return ways;
+}
+
+bool PlacementCounter::count( const ShotEvidence& evidence, double cellChance[CellCountSize] ) {
+    for( int i=0; i<CellCountSize; i++ ) {
+	cellChance[i] = 0;
+    }
+    used.clear();
+    outOfStates = false;
+    tried = 0;
+    if( ++currentStamp == 0 ) {
+	// Wrapped around: clear the stamps for real.
+	for( size_t i=0; i<table.size(); i++ ) {
+	    table[i].stamp = 0;
+	}
+	currentStamp = 1;
+    }
+    if( evidence.numShips < 1 || evidence.numShips > MaxFleetShips ) {
+	return false;
+    }
+    hits = evidence.hits;
+
+    // Longest first, and this is needed for the counts to be right, not just
+    // fast. A state keeps only the taken cells that later ships could use
+    // (reachable[depth]), and allowed() counts a hit outside those as not yet
+    // covered. With lengths not increasing, a later ship fits inside any
+    // placing of an earlier one, so every cell an earlier ship took is still
+    // in reachable[] and no covered hit is dropped from a state. In any other
+    // order a shorter ship's cells can fall outside it, and fleets that fit
+    // are lost (counttest shows this). So the order is set here, whatever
+    // order the evidence lists the ships in.
+    numShips = evidence.numShips;
+    for( int i=0; i<numShips; i++ ) {
+	shipLengths[i] = evidence.shipLengths[i];
+    }
+    sort(shipLengths, shipLengths+numShips, greater<int>());
+    findPlacements(evidence);
+    if( ! allowed(0, 0) ) {
+	return false;
+    }
+
+    double total = waysFrom(0, 0);
+    if( outOfStates || total <= 0 ) {
+	return false;
+    }
+
+    // Forward pass, one depth at a time: each placing of ship depth adds
+    // (ways to get here) * (ways to finish from there) to its cells.
+    double cellWays[CellCountSize] = {0};
+    table[findState(0, 0)].reach = 1;
+    for( int depth=0; depth<numShips; depth++ ) {
+	for( size_t u=0; u<used.size(); u++ ) {
+	    State& state = table[used[u]];
+	    if( state.depth != depth || state.reach == 0 || state.ways == 0 ) continue;
+	    const vector<CellMask>& ships = placements[depth];
+	    tried += ships.size();
+	    for( size_t p=0; p<ships.size(); p++ ) {
+		if( ships[p] & state.cells ) continue;
+		CellMask taken = state.cells | ships[p];
+		if( ! allowed(depth+1, taken) ) continue;
+		CellMask next = taken & reachable[depth+1];
+		double ways = 1;
+		if( depth+1 < numShips ) {
+		    State& nextState = table[findState(depth+1, next)];
+		    ways = nextState.ways;
+		    nextState.reach += state.reach;
+		}
+		double added = state.reach * ways;
+		if( added == 0 ) continue;
+		for( CellMask cells = ships[p]; cells != 0; cells &= cells - 1 ) {
+		    cellWays[firstCell(cells)] += added;
+		}
+	    }
+	}
+    }
+
+    CellMask unshot = unshotCells(evidence, placementTable.board[evidence.boardSize]);
+    for( CellMask cells = unshot; cells != 0; cells &= cells - 1 ) {
+	int cell = firstCell(cells);
+	cellChance[cell] = cellWays[cell] / total;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * PlacementCounter.h: exact hit probabilities by counting fleet configurations.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Counts every way of placing the ships still afloat that fits the evidence
+ * (see ShotEvidence.h), and for each unshot cell how many of those ways put
+ * a ship on it. The ships are placed one at a time, longest first, and the
+ * number of ways to place the rest is memoized on the cells that the rest
+ * could still use, so positions reached in different orders are counted once.
+ * That key is only enough because of the order, so count() sorts the ships
+ * itself.
+ *
+ * Early in a game there are far too many positions to visit. count() gives
+ * up after maxStates memo entries and returns false; the caller then has to
+ * estimate instead (ShotSampler).
+ */
+
+#ifndef PLACEMENTCOUNTER_H	// Double inclusion protection
+#define PLACEMENTCOUNTER_H
+
+#include <vector>
+
+#include "ShotEvidence.h"
+#include "ShotSampler.h"
+
+using namespace std;
+
+class PlacementCounter {
+    public:
+	/**
+	 * @param maxStates Memo entries to allow before giving up.
+	 */
+	PlacementCounter( int maxStates );
+
+	/**
+	 * @brief Sets cellChance to the exact chance that each unshot cell holds a
+	 * ship (0 for cells already shot), every fitting configuration being
+	 * equally likely.
+	 * @return false if it ran out of states, or if no configuration fits.
+	 */
+	bool count( const ShotEvidence& evidence, double cellChance[CellCountSize] );
+
+	/**
+	 * @brief Memo entries used by the last count().
+	 */
+	int statesUsed();
+
+	/**
+	 * @brief Ship placements looked at by the last count(): the work it did,
+	 * for comparing with ShotSampler::placementsTried().
+	 */
+	long placementsTried();
+
+    private:
+	struct State {
+	    CellMask cells;	// Cells taken by earlier ships, among those later ships can use.
+	    double ways;	// Ways to place ships depth.. from here.
+	    double reach;	// Ways to get here placing ships 0..depth-1.
+	    int depth;
+	    unsigned stamp;	// Entry is in use when stamp == currentStamp.
+	};
+
+	void findPlacements( const ShotEvidence& evidence );
+	double waysFrom( int depth, CellMask cells );
+	int findState( int depth, CellMask cells );
+	bool allowed( int depth, CellMask taken );
+
+	int maxStates;
+	vector<State> table;	// Open addressing, a power of two in size.
+	vector<int> used;	// Table entries used, in the order they were made.
+	unsigned currentStamp;
+	bool outOfStates;
+	long tried;
+
+	int numShips;
+	int shipLengths[MaxFleetShips];	// Ships afloat, longest first (see count()).
+	CellMask hits;
+	vector<CellMask> placements[MaxFleetShips];
+	CellMask reachable[MaxFleetShips+1];	// Cells ships depth.. could cover.
+
+	// Not copyable.
+	PlacementCounter( const PlacementCounter& );
+	void operator=( const PlacementCounter& );
+};
+
+#endif
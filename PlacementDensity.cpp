@@ -0,0 +1,70 @@
+/**
+ * PlacementDensity.cpp: counts ship placements through each cell of a board line.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef PLACEMENTDENSITY_CPP	// Double inclusion protection
+#define PLACEMENTDENSITY_CPP
+
+#include "PlacementDensity.h"
+
+void clearFleet( FleetCounts& fleet ) {
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	fleet.count[length] = 0;
+    }
+}
+
+int fleetSize( const FleetCounts& fleet ) {
+    int ships = 0;
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	ships += fleet.count[length];
+    }
+    return ships;
+}
+
+void lineDensity( LineMask open, int lineLength, const FleetCounts& fleet, int density[] ) {
+    for( int c=0; c<lineLength; c++ ) {
+	density[c] = 0;
+    }
+
+    // starts has bit s set when cells s .. s+length-1 are all open. Cells past
+    // the end of the line are never open, so off-board placements drop out.
+    LineMask starts = open;
+    for( int length=1; length<=MAX_SHIP_SIZE; length++ ) {
+	if( length > 1 ) {
+	    starts &= open >> (length-1);
+	}
+	int ships = fleet.count[length];
+	if( ships == 0 || starts == 0 ) continue;
+
+	LineMask window = (LineMask(1) << length) - 1;	// Starts that cover cell c: c-length+1 .. c
+	for( int c=0; c<lineLength; c++ ) {
+	    LineMask covering = c >= length-1 ? starts & (window << (c-length+1))
+	                                      : starts & ((LineMask(1) << (c+1)) - 1);
+	    density[c] += ships * __builtin_popcountll(covering);
+	}
+    }
+}
+
+void closeLineCell( LineMask open, int cell, const FleetCounts& fleet, int density[] ) {
+    LineMask starts = open;
+    for( int length=1; length<=MAX_SHIP_SIZE; length++ ) {
+	if( length > 1 ) {
+	    starts &= open >> (length-1);
+	}
+	int ships = fleet.count[length];
+	if( ships == 0 ) continue;
+
+	// The placements through cell start at cell-length+1 .. cell.
+	int first = cell-length+1 < 0 ? 0 : cell-length+1;
+	for( LineMask through = (starts >> first) & ((LineMask(2) << (cell-first)) - 1); through != 0; through &= through - 1 ) {
+	    int start = first + __builtin_ctzll(through);
+	    for( int c=start; c<start+length; c++ ) {
+		density[c] -= ships;
+	    }
+	}
+    }
+}
+
+#endif
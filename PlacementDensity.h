@@ -0,0 +1,58 @@
+/**
+ * PlacementDensity.h: counts ship placements through each cell of a board line.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A line (one row, or one column) is given as a bitmask of its open cells:
+ * bit i is set if cell i could still hold part of an unsunk ship. For a ship
+ * of length L the legal start cells are open & open>>1 & ... & open>>(L-1),
+ * and the number of placements covering cell c is the popcount of those
+ * starts in [c-L+1, c]. Every fleet length is done with the same few shifts,
+ * ANDs and popcounts, with no per-cell compares. When one cell closes, only
+ * the placements through it go, so closeLineCell() updates the counts of the
+ * cells within MAX_SHIP_SIZE-1 of it instead of recounting the line.
+ */
+
+#ifndef PLACEMENTDENSITY_H	// Double inclusion protection
+#define PLACEMENTDENSITY_H
+
+#include <cstdint>
+
+#include "defines.h"
+
+typedef uint64_t LineMask;	// Bit i = cell i of a row or column.
+
+const int MaxLineLength = 64;
+
+/**
+ * The enemy fleet as a count of ships of each length.
+ */
+struct FleetCounts {
+    int count[MAX_SHIP_SIZE+1];		// count[L] = ships of length L
+};
+
+/**
+ * @brief Sets every count to zero.
+ */
+void clearFleet( FleetCounts& fleet );
+
+/**
+ * @brief Number of ships in the fleet.
+ */
+int fleetSize( const FleetCounts& fleet );
+
+/**
+ * @brief Fills density[0..lineLength-1] with the number of placements of each
+ * fleet ship (counted once per ship) that lie within the open cells of the
+ * line and cover that cell.
+ */
+void lineDensity( LineMask open, int lineLength, const FleetCounts& fleet, int density[] );
+
+/**
+ * @brief Takes the placements through cell out of density, the counts
+ * lineDensity() gave for open, leaving those for open without cell. Only
+ * density[cell-MAX_SHIP_SIZE+1 .. cell+MAX_SHIP_SIZE-1] is read or written.
+ */
+void closeLineCell( LineMask open, int cell, const FleetCounts& fleet, int density[] );
+
+#endif
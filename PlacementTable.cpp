@@ -0,0 +1,45 @@
+/**
+ * PlacementTable.cpp: every ship placement as a precomputed CellMask.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef PLACEMENTTABLE_CPP	// Double inclusion protection
+#define PLACEMENTTABLE_CPP
+
+#include "PlacementTable.h"
+
+static constexpr PlacementTable makePlacementTable() {
+    PlacementTable table = {};
+    for( int length=1; length<=MAX_SHIP_SIZE; length++ ) {
+	for( int horiz=0; horiz<2; horiz++ ) {
+	    for( int row=0; row<MAX_BOARD_SIZE; row++ ) {
+		for( int col=0; col<MAX_BOARD_SIZE; col++ ) {
+		    int endRow = horiz ? row : row+length-1;
+		    int endCol = horiz ? col+length-1 : col;
+		    if( endRow >= MAX_BOARD_SIZE || endCol >= MAX_BOARD_SIZE ) {
+			table.ship[length][horiz][row][col] = OffBoardBit;
+			continue;
+		    }
+		    CellMask mask = 0;
+		    for( int i=0; i<length; i++ ) {
+			mask |= horiz ? cellBit(row, col+i) : cellBit(row+i, col);
+		    }
+		    table.ship[length][horiz][row][col] = mask;
+		}
+	    }
+	}
+    }
+    for( int size=0; size<=MAX_BOARD_SIZE; size++ ) {
+	for( int row=0; row<size; row++ ) {
+	    for( int col=0; col<size; col++ ) {
+		table.board[size] |= cellBit(row, col);
+	    }
+	}
+    }
+    return table;
+}
+
+constexpr PlacementTable placementTable = makePlacementTable();
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * PlacementTable.h: every ship placement as a precomputed CellMask.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The table is built at compile time (PlacementTable.cpp) and is read-only,
+ * so every board, player and thread shares the one copy. Because a CellMask
+ * uses the same bit for a cell whatever the board size, a placement's mask is
+ * the same on every board size; what changes with the size is only which
+ * cells are outside the board. Placements that would leave even a
+ * MAX_BOARD_SIZE board carry OffBoardBit, which no board contains. So
+ *
+ *     (placementMask(length, horiz, row, col) & (shipCells | outsideBoard(size))) == 0
+ *
+ * checks both "on the board" and "no overlap" with one AND.
+ */
+
+#ifndef PLACEMENTTABLE_H	// Double inclusion protection
+#define PLACEMENTTABLE_H
+
+#include "defines.h"
+#include "CellMask.h"
+
+const CellMask OffBoardBit = CellMask(1) << 127;	// Never a real cell.
+
+struct PlacementTable {
+    CellMask ship[MAX_SHIP_SIZE+1][2][MAX_BOARD_SIZE][MAX_BOARD_SIZE];	// [length][horiz][row][col]
+    CellMask board[MAX_BOARD_SIZE+1];	// Cells of an n x n board.
+};
+
+extern const PlacementTable placementTable;
+
+/**
+ * @brief Cells covered by a ship of the given length with its top/left end at
+ * row, col. Includes OffBoardBit if any part of it is off a MAX_BOARD_SIZE board
+ * or the length is not 1 to MAX_SHIP_SIZE.
+ */
+inline CellMask placementMask( int length, bool horiz, int row, int col ) {
+    if( length < 1 || length > MAX_SHIP_SIZE || row < 0 || row >= MAX_BOARD_SIZE || col < 0 || col >= MAX_BOARD_SIZE ) {
+	return OffBoardBit;
+    }
+    return placementTable.ship[length][horiz][row][col];
+}
+
+/**
+ * @brief Every bit that is not a cell of a boardSize x boardSize board.
+ */
+inline CellMask outsideBoard( int boardSize ) {
+    return ~placementTable.board[boardSize];
+}
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * PlayerPlugin.h: builds a player as a shared object the drivers can load.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A plugin is a player's sources compiled with -fPIC -shared (see the
+ * HuntPlayer.so rule in the Makefile) plus one line naming the player:
+ *
+ *     PLAYER_PLUGIN( HuntPlayer, "Hunt Player plugin", MAX_LARGE_BOARD_SIZE, true );
+ *
+ * The drivers load plugins with -l (see PlayerPlugins.h) and list them
+ * after their own players, so a new build can play without relinking them.
+ * PlayerV2, PlayerV3 and the other shared classes come from the driver,
+ * which exports them, so a plugin holds only its own code. It must be
+ * built from the same headers as the driver; the version catches plugins
+ * built before the interface last changed.
+ */
+
+#ifndef PLAYERPLUGIN_H		// Double inclusion protection
+#define PLAYERPLUGIN_H
+
+#include "PlayerV2.h"
+
+// Bump when PlayerV2, PlayerV3, Move or this struct change.
+const int PlayerPluginVersion = 1;
+
+struct PlayerPluginInfo {
+    int version;		// PlayerPluginVersion when the plugin was built
+    const char* name;
+    int maxBoardSize;		// Largest board the player can play
+    bool roundIndependent;	// Keeps nothing from one round to the next
+    PlayerV2* (*create)( int boardSize );	// NULL for an engine (see PlayerPlugins.h)
+};
+
+/**
+ * Defines playerPluginInfo(), the one function a driver looks up in a
+ * plugin. The players it creates are deleted by the driver.
+ */
+#define PLAYER_PLUGIN( PlayerClass, playerName, maxBoardSize, roundIndependent ) \
+    static PlayerV2* createPluginPlayer( int boardSize ) { \
+	return new PlayerClass( boardSize ); \
+    } \
+    extern "C" __attribute__((visibility("default"))) const PlayerPluginInfo* playerPluginInfo() { \
+	static const PlayerPluginInfo info = { PlayerPluginVersion, playerName, maxBoardSize, roundIndependent, createPluginPlayer }; \
+	return &info; \
+    }
+
+#endif
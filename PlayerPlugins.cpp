@@ -0,0 +1,108 @@
+/**
+ * PlayerPlugins.cpp: loads player plugins (see PlayerPlugin.h).
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef PLAYERPLUGINS_CPP	// Double inclusion protection
+#define PLAYERPLUGINS_CPP
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <dirent.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+
+#include "PlayerPlugins.h"
+#include "EnginePlayer.h"
+
+using namespace std;
+
+static vector<const PlayerPluginInfo*> plugins;
+static vector<string> engineCommands;	// [plugin]; empty for a shared object
+
+static bool loadPlayerPlugin( const string& fileName ) {
+    // Without a '/', dlopen() would search the library path instead.
+    string path = fileName.find('/') == string::npos ? "./" + fileName : fileName;
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if( ! handle ) {
+	cerr << "Cannot load plugin: " << dlerror() << endl;
+	return false;
+    }
+    typedef const PlayerPluginInfo* (*InfoFunction)();
+    InfoFunction info = (InfoFunction)dlsym(handle, "playerPluginInfo");
+    if( ! info ) {
+	cerr << "'" << fileName << "' is not a player plugin (no playerPluginInfo)" << endl;
+	dlclose(handle);
+	return false;
+    }
+    const PlayerPluginInfo* plugin = info();
+    if( plugin->version != PlayerPluginVersion ) {
+	cerr << "'" << fileName << "' is plugin version " << plugin->version
+	     << "; this driver needs version " << PlayerPluginVersion << ". Rebuild it." << endl;
+	dlclose(handle);
+	return false;
+    }
+    plugins.push_back(plugin);
+    engineCommands.push_back("");
+    return true;
+}
+
+bool loadPlayerPlugins( const string& path ) {
+    struct stat info;
+    if( stat(path.c_str(), &info) != 0 || ! S_ISDIR(info.st_mode) ) {
+	return loadPlayerPlugin(path);
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if( ! dir ) {
+	cerr << "Cannot read plugin directory '" << path << "'" << endl;
+	return false;
+    }
+    vector<string> fileNames;
+    while( struct dirent* entry = readdir(dir) ) {
+	string name = entry->d_name;
+	if( name.size() > 3 && name.compare(name.size()-3, 3, ".so") == 0 ) {
+	    fileNames.push_back(path + "/" + name);
+	}
+    }
+    closedir(dir);
+    sort(fileNames.begin(), fileNames.end());
+    for( size_t i=0; i<fileNames.size(); i++ ) {
+	if( ! loadPlayerPlugin(fileNames[i]) ) return false;
+    }
+    return true;
+}
+
+bool loadEnginePlayer( const string& command ) {
+    EnginePlayer probe(command, 0);
+    if( ! probe.started() ) return false;
+    // Kept, like a plugin's, until the program exits.
+    PlayerPluginInfo* engine = new PlayerPluginInfo();
+    engine->version = PlayerPluginVersion;
+    engine->name = (new string(probe.engineName()))->c_str();
+    engine->maxBoardSize = probe.engineMaxBoardSize();
+    engine->roundIndependent = false;	// Who knows what it remembers
+    engine->create = NULL;
+    plugins.push_back(engine);
+    engineCommands.push_back(command);
+    return true;
+}
+
+int numPlayerPlugins() {
+    return plugins.size();
+}
+
+const PlayerPluginInfo& playerPlugin( int index ) {
+    return *plugins[index];
+}
+
+PlayerV2* createPluginPlayer( int index, int boardSize ) {
+    if( plugins[index]->create ) {
+	return plugins[index]->create(boardSize);
+    }
+    return new EnginePlayer(engineCommands[index], boardSize);
+}
+
+#endif
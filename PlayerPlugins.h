@@ -0,0 +1,52 @@
+/**
+ * PlayerPlugins.h: loads player plugins (see PlayerPlugin.h).
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Each plugin is opened once, before any match starts, and its
+ * PlayerPluginInfo is kept. After that nothing here changes, so worker
+ * threads read the list without locking. Creating a plugin player costs
+ * one call through a function pointer, and its moves are virtual calls
+ * like any other player's; the bench shows plugin players beside the
+ * built-in ones. Plugins stay loaded until the program exits, since
+ * their players may still be around.
+ *
+ * Engines (players in their own process, see EnginePlayer.h) join the same
+ * list; their entries have no create function, so make players with
+ * createPluginPlayer().
+ */
+
+#ifndef PLAYERPLUGINS_H		// Double inclusion protection
+#define PLAYERPLUGINS_H
+
+#include <string>
+
+#include "PlayerPlugin.h"
+
+using namespace std;
+
+/**
+ * @brief Loads a plugin, or every .so file in a directory (in name order).
+ * Prints why and returns false if one can't be loaded.
+ */
+bool loadPlayerPlugins( const string& path );
+
+/**
+ * @brief Starts an engine once to learn its name and largest board, and
+ * adds it to the list. Prints why and returns false if it doesn't start.
+ */
+bool loadEnginePlayer( const string& command );
+
+int numPlayerPlugins();
+
+/**
+ * @brief Plugin number index, in the order they were loaded.
+ */
+const PlayerPluginInfo& playerPlugin( int index );
+
+/**
+ * @brief A new player from plugin number index, for a board of boardSize.
+ */
+PlayerV2* createPluginPlayer( int index, int boardSize );
+
+#endif
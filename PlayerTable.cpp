@@ -0,0 +1,76 @@
+/**
+ * PlayerTable.cpp: the players the tester (and bench) can pick from.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef PLAYERTABLE_CPP		// Double inclusion protection
+#define PLAYERTABLE_CPP
+
+#include "PlayerTable.h"
+#include "PlayerPlugins.h"
+
+// Include your player here
+//	Professor's contestants
+#include "CleanPlayerV2.h"
+#include "SemiSmartPlayerV2.h"
+#include "GamblerPlayerV2.h"
+#include "LearningGambler.h"
+
+// Change to include your player directly below
+#include "USSWhite.h"
+#include "HuntPlayer.h"
+#include "BatchStrategies.h"
+
+vector<string> playerNames = { 
+    "Clean Player",
+    "Semi-Smart Player",
+    "Gambler Player",
+    "Learning Gambler",
+    // Change to your player's name below
+    "USSWhite",
+    "Hunt Player",
+    // Batch simulator strategies (see BatchStrategies.h)
+    "Scan Strategy",
+    "Density Strategy"
+};
+
+// Players with fixed-size arrays stop at MAX_BOARD_SIZE.
+vector<int> playerMaxBoardSizes = {
+    MAX_BOARD_SIZE,
+    MAX_BOARD_SIZE,
+    MAX_BOARD_SIZE,
+    MAX_BOARD_SIZE,
+    MAX_BOARD_SIZE,
+    MAX_LARGE_BOARD_SIZE,
+    MAX_BOARD_SIZE,
+    MAX_BOARD_SIZE
+};
+
+void addPluginPlayers() {
+    for( int i=0; i<numPlayerPlugins(); i++ ) {
+	playerNames.push_back(playerPlugin(i).name);
+	playerMaxBoardSizes.push_back(playerPlugin(i).maxBoardSize);
+    }
+}
+
+PlayerV2* getPlayer( int playerId, int boardSize ) {
+    if( playerId >= NumBuiltinPlayers ) {
+	return createPluginPlayer(playerId - NumBuiltinPlayers, boardSize);
+    }
+    switch( playerId ) {
+	// Professor provided
+	default:
+	case 0: return new CleanPlayerV2( boardSize );
+	case 1: return new SemiSmartPlayerV2( boardSize );
+	case 2: return new GamblerPlayerV2( boardSize );
+	case 3: return new LearningGambler( boardSize );
+	// Change for your player's AI below
+	case 4: return new USSWhite( boardSize );
+	case 5: return new HuntPlayer( boardSize );
+	case 6: return new BatchPlayer<ScanStrategy>( boardSize );
+	case 7: return new BatchPlayer<DensityStrategy>( boardSize );
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * PlayerTable.h: the players the tester (and bench) can pick from.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * To add a player, bump NumBuiltinPlayers, add its name to playerNames and
+ * the largest board it can play to playerMaxBoardSizes in PlayerTable.cpp,
+ * and add a case to getPlayer(). Or build it as a plugin (see PlayerPlugin.h)
+ * and load it with -l: addPluginPlayers() puts the loaded plugins (and
+ * engines, -x) after the built-in players.
+ */
+
+#ifndef PLAYERTABLE_H		// Double inclusion protection
+#define PLAYERTABLE_H
+
+#include <string>
+#include <vector>
+
+#include "PlayerV2.h"
+
+using namespace std;
+
+const int NumBuiltinPlayers = 8;
+
+// Every player: the built-in ones, then the plugins and engines.
+extern vector<string> playerNames;
+extern vector<int> playerMaxBoardSizes;
+
+inline int numPlayers() {
+    return playerNames.size();
+}
+
+/**
+ * @brief Adds the plugins and engines loaded so far (see PlayerPlugins.h) to the table.
+ * Call once, after loading them and before playing.
+ */
+void addPluginPlayers();
+
+/**
+ * @brief Creates a new player by its number in playerNames.
+ */
+PlayerV2* getPlayer( int playerId, int boardSize );
+
+#endif
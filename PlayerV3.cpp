@@ -0,0 +1,39 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ */
+
+#ifndef PLAYERV3_CPP		// Double inclusion protection
+#define PLAYERV3_CPP
+
+#include "PlayerV3.h"
+
+PlayerV3::PlayerV3( int boardSize )
+    :PlayerV2(boardSize)
+{
+}
+
+void PlayerV3::seedRandom( uint64_t key ) {
+    gameRandom.reset(key);
+}
+
+Message PlayerV3::getMove() {
+    return toMessage( nextMove() );
+}
+
+void PlayerV3::update( Message msg ) {
+    notify( toMove(msg) );
+}
+
+void PlayerV3::notifyKill( Move ship ) {
+    for( int i=0; i<ship.length; i++ ) {
+	notify( killCell(ship, i) );
+    }
+}
+
+Message PlayerV3::placeShip( int length ) {
+    return toMessage( nextPlacement(length) );
+}
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * PlayerV3: a PlayerV2 that talks in Move records instead of Messages.
+ * AIContest notices a PlayerV3 and calls the Move functions directly, so no
+ * Message (and no string) is built per shot. The PlayerV2 functions are
+ * implemented here by conversion, so a PlayerV3 can still be used anywhere
+ * a PlayerV2 is expected.
+ */
+
+#ifndef PLAYERV3_H
+#define PLAYERV3_H		// Double inclusion protection
+
+#include "PlayerV2.h"
+#include "Move.h"
+#include "GameRandom.h"
+
+class PlayerV3 : public PlayerV2 {
+    public:
+        PlayerV3( int boardSize );
+
+	/**
+	 * @brief Gets the player's shot. Same as PlayerV2::getMove().
+	 * @return Move with type SHOT and the row, col to shoot at.
+	 */
+	virtual Move nextMove() = 0;
+
+	/**
+	 * @brief Informs the player of a result. Same as PlayerV2::update().
+	 * @param move The type is the result (HIT, MISS, KILL, OPPONENT_SHOT, WIN, ...)
+	 * and row, col are the cell it applies to.
+	 */
+	virtual void notify( Move move ) = 0;
+
+	/**
+	 * @brief Informs the player that its shot sank a ship (after the HIT for
+	 * the shot itself).
+	 * @param ship Type KILL; row, col are the ship's top/left cell, and dir,
+	 * length and shipId say the rest.
+	 * By default this calls notify() with a KILL for each cell of the ship,
+	 * top/left first, which is what PlayerV2 players get as update()s.
+	 */
+	virtual void notifyKill( Move ship );
+
+	/**
+	 * @brief Gets a ship placement. Same as PlayerV2::placeShip().
+	 * @return Move with type PLACE_SHIP, the top/left row, col, dir and length.
+	 */
+	virtual Move nextPlacement( int length ) = 0;
+
+	/**
+	 * @brief Starts the player's random stream for the next game. AIContest
+	 * calls it before newRound() with a key made from the game's seed.
+	 */
+	virtual void seedRandom( uint64_t key );
+
+	// PlayerV2 interface, by conversion.
+	Message getMove();
+	void update( Message msg );
+	Message placeShip( int length );
+
+    protected:
+	// Random numbers for this game; use instead of rand() so games replay exactly.
+	GameRandom gameRandom;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * ReferenceBoard.h: the original BoardV3 from binaries.tar, for boardtest.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The provided BoardV3.o is the char-array board BoardV3.cpp replaced. The
+ * Makefile extracts it and renames its symbols from BoardV3 to BoardV0
+ * (ReferenceBoard.o), so it links next to today's BoardV3. This is its
+ * original declaration under that name; the layout must match the binary.
+ */
+
+#ifndef REFERENCEBOARD_H	// Double inclusion protection
+#define REFERENCEBOARD_H
+
+#include "defines.h"
+
+using namespace std;
+
+class BoardV0 {
+    public:
+	BoardV0( int width );
+	BoardV0( const BoardV0& other );
+	void operator=( const BoardV0& other );
+	bool placeShip( int row, int col, int length, Direction dir );
+	char getOpponentView( int row, int col );
+	char getOwnerView( int row, int col );
+	char getShipMark( int row, int col );
+	char processShot( int row, int col );
+	bool hasWon();
+
+	const static int MaxBoardSize = 10;
+
+    private:
+	void initialize( char board[MaxBoardSize][MaxBoardSize] );
+	bool positionOk( int row, int col, int length, bool horiz );
+	void markShip( int row, int col, int length, bool horiz );
+	bool isSunk( int row, int col );
+	void markSunk( int row, int col );
+
+	char shipBoard[MaxBoardSize][MaxBoardSize];
+	char shotBoard[MaxBoardSize][MaxBoardSize];
+	int boardSize;
+	char shipMark;
+};
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * ReplayLog.cpp: compact binary record of every game played.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef REPLAYLOG_CPP		// Double inclusion protection
+#define REPLAYLOG_CPP
+
+#include <iostream>
+
+#include "ReplayLog.h"
+#include "defines.h"
+
+using namespace std;
+
+GameRecord::GameRecord() {
+    header.reserve(64);
+    record.reserve(1024);
+    shots.reserve(1024);
+    boardSize = 0;
+    numShots = 0;
+    placed[0] = placed[1] = 0;
+    placedAt[0] = placedAt[1] = 0;
+}
+
+void GameRecord::begin( uint64_t gameSeed, int player1Id, int player2Id, int boardSize,
+			const int shipLengths[], int numShips ) {
+    this->boardSize = boardSize;
+    numShots = 0;
+    header.clear();
+    shots.clear();
+    for( int i=0; i<8; i++ ) {
+	header.push_back((unsigned char)(gameSeed >> (8*i)));
+    }
+    putVarint(header, player1Id);
+    putVarint(header, player2Id);
+    putVarint(header, boardSize);
+    header.push_back((unsigned char)numShips);
+    for( int i=0; i<numShips; i++ ) {
+	header.push_back((unsigned char)shipLengths[i]);
+    }
+    // Player 1's count goes here now; player 2's once player 1 has finished.
+    placed[0] = placed[1] = 0;
+    placedAt[0] = header.size();
+    placedAt[1] = 0;
+    header.push_back(0);
+}
+
+void GameRecord::placement( int player, Move location ) {
+    if( player == 1 && placedAt[1] == 0 ) {
+	placedAt[1] = header.size();
+	header.push_back(0);
+    }
+    int cell = location.row*boardSize + location.col;
+    putVarint(header, (uint64_t)cell*2 + (location.dir == Horizontal));
+    header[placedAt[player]] = (unsigned char)++placed[player];
+}
+
+void GameRecord::shot( int row, int col, char result ) {
+    bool onBoard = row >= 0 && row < boardSize && col >= 0 && col < boardSize;
+    int cell = onBoard ? row*boardSize + col : boardSize*boardSize;
+    ReplayResult code = result == MISS ? ReplayMiss : result == HIT ? ReplayHit
+		      : result == KILL ? ReplayKill : ReplayOther;
+    putVarint(shots, (uint64_t)cell*4 + code);
+    numShots++;
+}
+
+static size_t varintSize( uint64_t n ) {
+    size_t size = 1;
+    while( n >= 0x80 ) {
+	n >>= 7;
+	size++;
+    }
+    return size;
+}
+
+void GameRecord::end( bool player1Won, bool player2Won ) {
+    if( placedAt[1] == 0 ) {
+	// Player 1 forfeited before player 2 placed anything.
+	placedAt[1] = header.size();
+	header.push_back(0);
+    }
+    record.clear();
+    putVarint(record, header.size() + varintSize(numShots) + shots.size() + 1);
+    record.insert(record.end(), header.begin(), header.end());
+    putVarint(record, numShots);
+    record.insert(record.end(), shots.begin(), shots.end());
+    record.push_back((unsigned char)(player1Won + 2*player2Won));
+}
+
+const vector<unsigned char>& GameRecord::bytes() {
+    return record;
+}
+
+ReplayWriter::ReplayWriter( const string& fileName, const string playerNames[], int numPlayers ) {
+    stopping = false;
+    failed = false;
+    filling.reserve(ChunkSize + 1024);
+    file = fopen(fileName.c_str(), "wb");
+    if( ! file ) {
+	cerr << "Cannot open replay file '" << fileName << "'" << endl;
+	failed = true;
+	return;
+    }
+    filling.insert(filling.end(), ReplayMagic, ReplayMagic + sizeof(ReplayMagic));
+    filling.push_back(ReplayVersion);
+    putVarint(filling, numPlayers);
+    for( int i=0; i<numPlayers; i++ ) {
+	putVarint(filling, playerNames[i].size());
+	filling.insert(filling.end(), playerNames[i].begin(), playerNames[i].end());
+    }
+    writer = thread(&ReplayWriter::writerLoop, this);
+}
+
+ReplayWriter::~ReplayWriter() {
+    if( ! file ) return;
+    {
+	unique_lock<mutex> guard(lock);
+	if( ! filling.empty() ) queueFilling();
+	stopping = true;
+    }
+    chunkReady.notify_one();
+    writer.join();
+    if( fclose(file) != 0 ) failed = true;
+    if( failed ) cerr << "Error writing the replay file" << endl;
+}
+
+bool ReplayWriter::ok() {
+    return ! failed;
+}
+
+/**
+ * Hands the filling buffer to the writing thread and starts a new one.
+ * Called with the lock held.
+ */
+void ReplayWriter::queueFilling() {
+    pending.push_back(vector<unsigned char>());
+    pending.back().swap(filling);
+    if( ! spare.empty() ) {
+	filling.swap(spare.back());
+	spare.pop_back();
+    } else {
+	filling.reserve(ChunkSize + 1024);
+    }
+}
+
+void ReplayWriter::write( const vector<unsigned char>& record ) {
+    if( ! file ) return;
+    unique_lock<mutex> guard(lock);
+    filling.insert(filling.end(), record.begin(), record.end());
+    if( filling.size() < ChunkSize ) return;
+    while( pending.size() >= MaxPendingChunks ) {
+	chunkWritten.wait(guard);
+    }
+    queueFilling();
+    chunkReady.notify_one();
+}
+
+void ReplayWriter::writerLoop() {
+    unique_lock<mutex> guard(lock);
+    while( true ) {
+	while( pending.empty() && ! stopping ) {
+	    chunkReady.wait(guard);
+	}
+	if( pending.empty() ) {
+	    return;		// Stopping and everything written.
+	}
+	vector<unsigned char> chunk;
+	chunk.swap(pending.front());
+	pending.pop_front();
+
+	guard.unlock();
+	bool written = fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+	guard.lock();
+
+	if( ! written ) failed = true;
+	chunk.clear();
+	spare.push_back(vector<unsigned char>());
+	spare.back().swap(chunk);
+	chunkWritten.notify_all();
+    }
+}
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * ReplayLog.h: compact binary record of every game played.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A replay file is a header followed by one record per game. Numbers are
+ * unsigned LEB128 varints (7 bits a byte, low bits first) unless noted.
+ *
+ * Header:
+ *   "BSRP", version byte (ReplayVersion), number of players, then each
+ *   player name as its length and bytes. Player ids in the records index
+ *   this list.
+ *
+ * Record (the length of the rest first, so a reader can skip a record):
+ *   length
+ *   game seed		8 bytes, little-endian (see GameRandom.h)
+ *   player 1 id, player 2 id, board size
+ *   number of ships	one byte
+ *   ship lengths	one byte each
+ *   placements		for each player, the number placed (one byte), then
+ *			each one as (row*boardSize + col)*2 + horizontal. A
+ *			player that placed fewer than all ships forfeited.
+ *   shots		the number of shots, then each one as
+ *			cell*4 + ReplayResult, where cell is row*boardSize + col,
+ *			or boardSize*boardSize for a shot off the board. Player
+ *			1 and player 2 take turns, player 1 first.
+ *   outcome		one byte: 1 if player 1 won, plus 2 if player 2 won.
+ *
+ * On a 10x10 board a shot takes one byte for the first 32 cells and two for
+ * the rest, so a game is about 1.7 bytes a shot plus some 40 bytes.
+ *
+ * Each AIContest fills its own GameRecord and hands the finished record to
+ * a ReplayWriter, which is shared by every thread. The writer only copies
+ * the record into a buffer; a background thread writes the full buffers
+ * to the file, so the games never wait for the disk unless it falls
+ * MaxPendingChunks behind. ReplayReader.h reads the files back.
+ */
+
+#ifndef REPLAYLOG_H		// Double inclusion protection
+#define REPLAYLOG_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Move.h"
+
+using namespace std;
+
+const char ReplayMagic[4] = { 'B', 'S', 'R', 'P' };
+const int ReplayVersion = 1;
+
+enum ReplayResult { ReplayMiss=0, ReplayHit, ReplayKill, ReplayOther };
+
+/**
+ * Appends n to buffer as a varint.
+ */
+inline void putVarint( vector<unsigned char>& buffer, uint64_t n ) {
+    while( n >= 0x80 ) {
+	buffer.push_back((unsigned char)(n | 0x80));
+	n >>= 7;
+    }
+    buffer.push_back((unsigned char)n);
+}
+
+/**
+ * Reads a varint at pos, moving pos past it. Returns false, leaving pos
+ * alone, if the varint runs past end or is too long.
+ */
+inline bool getVarint( const unsigned char*& pos, const unsigned char* end, uint64_t& n ) {
+    n = 0;
+    for( const unsigned char* p = pos; p < end && p - pos < 10; p++ ) {
+	n |= (uint64_t)(*p & 0x7f) << (7*(p - pos));
+	if( *p < 0x80 ) {
+	    pos = p + 1;
+	    return true;
+	}
+    }
+    return false;
+}
+
+/**
+ * One game's record, built up as the game is played. Reused from game to
+ * game, so after the first few games it allocates nothing.
+ */
+class GameRecord {
+    public:
+	GameRecord();
+
+	void begin( uint64_t gameSeed, int player1Id, int player2Id, int boardSize,
+		    const int shipLengths[], int numShips );
+	/**
+	 * @brief Records a ship that was placed. All of player 1's come first.
+	 */
+	void placement( int player, Move location );
+	/**
+	 * @brief Records a shot and its result (a Move type from defines.h).
+	 */
+	void shot( int row, int col, char result );
+	/**
+	 * @brief Finishes the record; bytes() is then ready to write.
+	 */
+	void end( bool player1Won, bool player2Won );
+
+	const vector<unsigned char>& bytes();
+
+    private:
+	vector<unsigned char> header;	// Seed to the end of the placements.
+	vector<unsigned char> shots;
+	vector<unsigned char> record;
+	int boardSize;
+	int numShots;
+	int placed[2];
+	size_t placedAt[2];		// Where each player's placement count is in header.
+};
+
+class ReplayWriter {
+    public:
+	/**
+	 * @brief Opens (truncates) the file, writes the header and starts the
+	 * writing thread. Check ok() before use.
+	 */
+	ReplayWriter( const string& fileName, const string playerNames[], int numPlayers );
+	/**
+	 * @brief Writes everything still buffered and closes the file.
+	 */
+	~ReplayWriter();
+
+	bool ok();
+
+	/**
+	 * @brief Queues a finished record. Safe to call from any thread.
+	 */
+	void write( const vector<unsigned char>& record );
+
+	// Buffer size handed to the writing thread, and how many may wait.
+	const static size_t ChunkSize = 1 << 16;
+	const static size_t MaxPendingChunks = 64;
+
+    private:
+	void writerLoop();
+	void queueFilling();
+
+	FILE* file;
+	vector<unsigned char> filling;		// Records not yet handed over.
+	deque< vector<unsigned char> > pending;	// Full buffers to write, oldest first.
+	vector< vector<unsigned char> > spare;	// Written buffers, for reuse.
+	mutex lock;
+	condition_variable chunkReady;
+	condition_variable chunkWritten;
+	bool stopping;
+	bool failed;
+	thread writer;
+
+	// Not copyable.
+	ReplayWriter( const ReplayWriter& );
+	void operator=( const ReplayWriter& );
+};
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * ReplayReader.cpp: reads replay files (see ReplayLog.h) in place.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef REPLAYREADER_CPP	// Double inclusion protection
+#define REPLAYREADER_CPP
+
+#include <iostream>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ReplayReader.h"
+#include "defines.h"
+
+using namespace std;
+
+/**
+ * True if placement (as ReplayLog.h writes it) puts a ship of the given
+ * length wholly on the board.
+ */
+static bool placementFits( uint64_t placement, int length, int boardSize ) {
+    uint64_t cell = placement >> 1;
+    if( cell >= (uint64_t)boardSize*boardSize ) return false;
+    int row = (int)cell / boardSize;
+    int col = (int)cell % boardSize;
+    return (placement & 1) ? col + length <= boardSize : row + length <= boardSize;
+}
+
+bool readReplayGame( const unsigned char*& pos, const unsigned char* end, ReplayGame& game ) {
+    const unsigned char* p = pos;
+    uint64_t length;
+    if( ! getVarint(p, end, length) || length > (uint64_t)(end - p) || length < 16 ) {
+	return false;
+    }
+    const unsigned char* recordEnd = p + length;
+
+    game.seed = 0;
+    for( int i=0; i<8; i++ ) {
+	game.seed |= (uint64_t)p[i] << (8*i);
+    }
+    p += 8;
+    uint64_t player1Id, player2Id, boardSize;
+    if( ! getVarint(p, recordEnd, player1Id) || ! getVarint(p, recordEnd, player2Id)
+	|| ! getVarint(p, recordEnd, boardSize) || p >= recordEnd ) {
+	return false;
+    }
+    if( player1Id > INT_MAX || player2Id > INT_MAX || boardSize < 1 || boardSize > MAX_LARGE_BOARD_SIZE ) {
+	return false;
+    }
+    game.playerIds[0] = (int)player1Id;
+    game.playerIds[1] = (int)player2Id;
+    game.boardSize = (int)boardSize;
+    game.numShips = *p++;
+    if( game.numShips > recordEnd - p ) return false;
+    game.shipLengths = p;
+    for( int i=0; i<game.numShips; i++ ) {
+	if( game.shipLengths[i] < 1 || game.shipLengths[i] > game.boardSize ) return false;
+    }
+    p += game.numShips;
+
+    // Placements have to be stepped over to find the shots. AIContest only
+    // records ships that went on the board, so anything else is a bad record.
+    for( int side=0; side<2; side++ ) {
+	if( p >= recordEnd ) return false;
+	game.numPlaced[side] = *p++;
+	if( game.numPlaced[side] > game.numShips ) return false;
+	game.placements[side] = p;
+	for( int i=0; i<game.numPlaced[side]; i++ ) {
+	    uint64_t placement;
+	    if( ! getVarint(p, recordEnd, placement) || ! placementFits(placement, game.shipLengths[i], game.boardSize) ) {
+		return false;
+	    }
+	}
+    }
+
+    // The shots run up to the outcome, the last byte. Each is checked here, so
+    // nextShot() can read them without bounds.
+    const unsigned char* shotsEnd = recordEnd - 1;
+    uint64_t numShots;
+    if( ! getVarint(p, shotsEnd, numShots) || numShots > (uint64_t)(shotsEnd - p) ) {
+	return false;
+    }
+    game.numShots = (int)numShots;
+    game.shots = p;
+    uint64_t offBoard = (uint64_t)game.boardSize * game.boardSize;
+    for( uint64_t i=0; i<numShots; i++ ) {
+	uint64_t shot;
+	if( ! getVarint(p, shotsEnd, shot) || (shot >> 2) > offBoard ) return false;
+    }
+    if( p != shotsEnd || *shotsEnd > 3 ) return false;
+    game.outcome = *shotsEnd;
+
+    pos = recordEnd;
+    return true;
+}
+
+ReplayReader::ReplayReader() {
+    fd = -1;
+    data = NULL;
+    size = 0;
+    recordsStart = 0;
+}
+
+ReplayReader::~ReplayReader() {
+    close();
+}
+
+void ReplayReader::close() {
+    if( data ) munmap((void*)data, size);
+    if( fd >= 0 ) ::close(fd);
+    fd = -1;
+    data = NULL;
+    size = 0;
+    recordsStart = 0;
+    names.clear();
+}
+
+bool ReplayReader::open( const string& fileName ) {
+    close();
+    fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat info;
+    if( fd < 0 || fstat(fd, &info) != 0 ) {
+	cerr << "Cannot open replay file '" << fileName << "'" << endl;
+	return false;
+    }
+    size = info.st_size;
+    if( size > 0 ) {
+	void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if( mapped == MAP_FAILED ) {
+	    cerr << "Cannot map replay file '" << fileName << "'" << endl;
+	    size = 0;
+	    return false;
+	}
+	data = (const unsigned char*)mapped;
+	madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+
+    // Header: magic, version, then the player names.
+    const unsigned char* p = data;
+    const unsigned char* fileEnd = data + size;
+    uint64_t numPlayers;
+    if( size < sizeof(ReplayMagic) + 1 || memcmp(data, ReplayMagic, sizeof(ReplayMagic)) != 0 ) {
+	cerr << "'" << fileName << "' is not a replay file" << endl;
+	return false;
+    }
+    p += sizeof(ReplayMagic);
+    if( *p++ != ReplayVersion ) {
+	cerr << "'" << fileName << "' is replay version " << (int)p[-1]
+	     << "; this reads version " << ReplayVersion << endl;
+	return false;
+    }
+    if( ! getVarint(p, fileEnd, numPlayers) ) {
+	cerr << "'" << fileName << "' has a cut-off header" << endl;
+	return false;
+    }
+    for( uint64_t i=0; i<numPlayers; i++ ) {
+	uint64_t length;
+	if( ! getVarint(p, fileEnd, length) || length > (uint64_t)(fileEnd - p) ) {
+	    cerr << "'" << fileName << "' has a cut-off header" << endl;
+	    return false;
+	}
+	names.push_back(string((const char*)p, length));
+	p += length;
+    }
+    recordsStart = p - data;
+    return true;
+}
+
+const vector<string>& ReplayReader::playerNames() {
+    return names;
+}
+
+const unsigned char* ReplayReader::begin() {
+    return data + recordsStart;
+}
+
+const unsigned char* ReplayReader::end() {
+    return data + size;
+}
+
+vector<size_t> ReplayReader::split( size_t partBytes ) {
+    vector<size_t> parts(1, 0);
+    const unsigned char* p = begin();
+    const unsigned char* last = end();
+    size_t nextSplit = partBytes;
+    while( p < last ) {
+	const unsigned char* record = p;
+	uint64_t length;
+	if( ! getVarint(p, last, length) || length > (uint64_t)(last - p) ) {
+	    p = record;
+	    break;
+	}
+	p += length;
+	if( (size_t)(p - begin()) >= nextSplit ) {
+	    parts.push_back(p - begin());
+	    nextSplit = p - begin() + partBytes;
+	}
+    }
+    if( parts.back() != (size_t)(p - begin()) ) {
+	parts.push_back(p - begin());
+    }
+    return parts;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * ReplayReader.h: reads replay files (see ReplayLog.h) in place.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The file is memory-mapped, and each record is looked at where it lies: a
+ * ReplayGame only points at the placements and shots inside the mapping,
+ * which the caller walks with nextPlacement() and nextShot(). Nothing is
+ * copied or allocated per game, so a scan runs at about the speed the file
+ * can be read.
+ *
+ * Records don't say where the next one starts except through their length,
+ * so to scan in parallel, split() first hops from length to length and
+ * returns offsets that divide the file into runs of whole records.
+ */
+
+#ifndef REPLAYREADER_H		// Double inclusion protection
+#define REPLAYREADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ReplayLog.h"
+
+using namespace std;
+
+/**
+ * One record, pointing into the mapped file.
+ */
+struct ReplayGame {
+    uint64_t seed;
+    int playerIds[2];
+    int boardSize;
+    int numShips;
+    const unsigned char* shipLengths;
+    int numPlaced[2];
+    const unsigned char* placements[2];	// Each player's first placement.
+    int numShots;
+    const unsigned char* shots;		// Player 1's first shot; players take turns.
+    int outcome;			// 1 if player 1 won, plus 2 if player 2 won.
+};
+
+/**
+ * @brief Reads the record at pos, moving pos to the next one. Every ship
+ * length, placement and shot is checked against the board size and the
+ * record's end.
+ * @return false if the record is cut off, doesn't parse, or has a ship or
+ * shot that couldn't have been played.
+ */
+bool readReplayGame( const unsigned char*& pos, const unsigned char* end, ReplayGame& game );
+
+/**
+ * @brief Reads a placement at pos (see ReplayGame::placements), moving pos on.
+ * Only for records readReplayGame() accepted, which it has checked.
+ */
+inline void nextPlacement( const unsigned char*& pos, int boardSize, int& row, int& col, bool& horizontal ) {
+    uint64_t n = 0;
+    getVarint(pos, pos + 10, n);
+    horizontal = n & 1;
+    row = (int)(n >> 1) / boardSize;
+    col = (int)(n >> 1) % boardSize;
+}
+
+/**
+ * @brief Reads a shot at pos (see ReplayGame::shots), moving pos on. cell is
+ * row*boardSize + col, or boardSize*boardSize for a shot off the board. Only
+ * for records readReplayGame() accepted, which it has checked.
+ */
+inline void nextShot( const unsigned char*& pos, int& cell, ReplayResult& result ) {
+    uint64_t n = *pos;
+    if( n < 0x80 ) {
+	pos++;		// Most shots on boards up to 10x10 are one or two bytes.
+    } else if( pos[1] < 0x80 ) {
+	n = (n & 0x7f) | (uint64_t)pos[1] << 7;
+	pos += 2;
+    } else {
+	getVarint(pos, pos + 10, n);
+    }
+    cell = (int)(n >> 2);
+    result = (ReplayResult)(n & 3);
+}
+
+class ReplayReader {
+    public:
+	ReplayReader();
+	~ReplayReader();
+
+	/**
+	 * @brief Maps the file and reads its header. Prints why and returns
+	 * false if it can't.
+	 */
+	bool open( const string& fileName );
+
+	const vector<string>& playerNames();
+
+	/**
+	 * @brief The records, as [begin(), end()).
+	 */
+	const unsigned char* begin();
+	const unsigned char* end();
+
+	/**
+	 * @brief Offsets from begin() that split the records into runs of about
+	 * partBytes each: parts[i] to parts[i+1]. The last offset is where the
+	 * last whole record ends; anything after it is a cut-off record.
+	 */
+	vector<size_t> split( size_t partBytes );
+
+    private:
+	void close();
+
+	int fd;
+	const unsigned char* data;
+	size_t size;
+	size_t recordsStart;
+	vector<string> names;
+
+	// Not copyable.
+	ReplayReader( const ReplayReader& );
+	void operator=( const ReplayReader& );
+};
+
+#endif
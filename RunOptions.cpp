@@ -0,0 +1,157 @@
+/**
+ * RunOptions.cpp: command line / config file settings shared by the drivers.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef RUNOPTIONS_CPP		// Double inclusion protection
+#define RUNOPTIONS_CPP
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "RunOptions.h"
+
+using namespace std;
+
+RunOptions::RunOptions() {
+    boardSize = 0;
+    totalGames = 0;
+    secondsPerMove = -1;
+    numThreads = 1;
+    seed = 0;
+    haveSeed = false;
+    player1 = -1;
+    player2 = -1;
+    showAllRounds = false;
+    batch = false;
+    stopError = 0;
+    paired = false;
+    timing = false;
+    moveLimit = 0;
+    gameLimit = 0;
+    pipelined = false;
+    timedTargeting = false;
+}
+
+/**
+ * Applies a single setting. Used for both flags and config file lines.
+ */
+static bool applySetting( const string& key, const string& value, RunOptions& options ) {
+    if( key == "boardSize" )		options.boardSize = atoi(value.c_str());
+    else if( key == "games" )		options.totalGames = atoi(value.c_str());
+    else if( key == "delay" )		options.secondsPerMove = atof(value.c_str());
+    else if( key == "threads" )		options.numThreads = atoi(value.c_str());
+    else if( key == "seed" ) {
+	options.seed = strtoull(value.c_str(), NULL, 10);
+	options.haveSeed = true;
+    }
+    else if( key == "player1" )		options.player1 = atoi(value.c_str());
+    else if( key == "player2" )		options.player2 = atoi(value.c_str());
+    else if( key == "showAllRounds" )	options.showAllRounds = atoi(value.c_str()) != 0;
+    else if( key == "batch" )		options.batch = atoi(value.c_str()) != 0;
+    else if( key == "replay" )		options.replayFile = value;
+    else if( key == "stopError" )	options.stopError = atof(value.c_str());
+    else if( key == "paired" )		options.paired = atoi(value.c_str()) != 0;
+    else if( key == "timing" )		options.timing = atoi(value.c_str()) != 0;
+    else if( key == "moveLimit" ) {
+	options.moveLimit = atof(value.c_str());
+	options.timing = true;
+    }
+    else if( key == "gameLimit" ) {
+	options.gameLimit = atof(value.c_str());
+	options.timing = true;
+    }
+    else if( key == "pipelined" )	options.pipelined = atoi(value.c_str()) != 0;
+    else if( key == "timedTargeting" )	options.timedTargeting = atoi(value.c_str()) != 0;
+    else if( key == "plugin" )		options.plugins.push_back(value);
+    else if( key == "engine" )		options.engines.push_back(value);
+    else return false;
+    return true;
+}
+
+static string trim( const string& str ) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if( first == string::npos ) return "";
+    size_t last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last-first+1);
+}
+
+bool readRunOptionsFile( const string& fileName, RunOptions& options ) {
+    ifstream in(fileName.c_str());
+    if( ! in ) {
+	cerr << "Cannot open config file '" << fileName << "'" << endl;
+	return false;
+    }
+
+    string line;
+    int lineNum = 0;
+    while( getline(in, line) ) {
+	lineNum++;
+	size_t comment = line.find('#');
+	if( comment != string::npos ) {
+	    line = line.substr(0, comment);
+	}
+	line = trim(line);
+	if( line.empty() ) continue;
+
+	size_t equals = line.find('=');
+	if( equals == string::npos || ! applySetting(trim(line.substr(0, equals)), trim(line.substr(equals+1)), options) ) {
+	    cerr << fileName << ":" << lineNum << ": bad setting '" << line << "'" << endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+bool parseRunOptions( int argc, char* argv[], RunOptions& options ) {
+    int opt;
+    while( (opt = getopt(argc, argv, "b:g:d:j:s:1:2:aqr:e:ptm:M:oTl:x:c:")) != -1 ) {
+	switch( opt ) {
+	    case 'b': applySetting("boardSize", optarg, options); break;
+	    case 'g': applySetting("games", optarg, options); break;
+	    case 'd': applySetting("delay", optarg, options); break;
+	    case 'j': applySetting("threads", optarg, options); break;
+	    case 's': applySetting("seed", optarg, options); break;
+	    case '1': applySetting("player1", optarg, options); break;
+	    case '2': applySetting("player2", optarg, options); break;
+	    case 'a': options.showAllRounds = true; break;
+	    case 'q': options.batch = true; break;
+	    case 'r': applySetting("replay", optarg, options); break;
+	    case 'e': applySetting("stopError", optarg, options); break;
+	    case 'p': options.paired = true; break;
+	    case 't': options.timing = true; break;
+	    case 'm': applySetting("moveLimit", optarg, options); break;
+	    case 'M': applySetting("gameLimit", optarg, options); break;
+	    case 'o': options.pipelined = true; break;
+	    case 'T': options.timedTargeting = true; break;
+	    case 'l': applySetting("plugin", optarg, options); break;
+	    case 'x': applySetting("engine", optarg, options); break;
+	    case 'c':
+		if( ! readRunOptionsFile(optarg, options) ) return false;
+		break;
+	    default:
+		cerr << "Usage: " << argv[0] << " [-b boardSize] [-g games] [-d secondsPerMove] [-j threads]" << endl
+		     << "       [-s seed] [-1 player] [-2 player] [-a] [-q] [-r replayFile] [-e stopError] [-p]" << endl
+		     << "       [-t] [-m moveLimitMs] [-M gameLimitMs] [-l plugin] [-x engineCommand]" << endl
+		     << "       [-o] [-T] [-c configFile]" << endl;
+		return false;
+	}
+    }
+    return true;
+}
+
+string jsonString( const string& str ) {
+    string quoted = "\"";
+    for( size_t i=0; i<str.size(); i++ ) {
+	if( str[i] == '"' || str[i] == '\\' ) {
+	    quoted += '\\';
+	}
+	quoted += str[i];
+    }
+    return quoted + "\"";
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * RunOptions.h: command line / config file settings shared by the drivers.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Anything not given on the command line or in a config file is asked for
+ * interactively, as before, unless batch mode (-q) is on. In batch mode the
+ * defaults below are used instead and nothing is read from cin.
+ *
+ * Command line flags:
+ *   -b <size>      board size
+ *   -g <games>     games (rounds) per match
+ *   -d <seconds>   seconds per displayed move
+ *   -j <threads>   worker threads (contest only)
+ *   -s <seed>      tournament seed
+ *   -1 <id>        first player (tester only)
+ *   -2 <id>        second player (tester only)
+ *   -a             display all rounds (tester only)
+ *   -q             batch mode: no display, no pauses, JSON summary only
+ *   -r <file>      record every game in a replay file (see ReplayLog.h)
+ *   -e <rate>      stop a match early once its winner is settled, naming the
+ *                  wrong winner at most this often (see SequentialTest.h)
+ *   -p             paired games: each game seed is played twice, the second
+ *                  time with the players' sides (and streams) swapped; both
+ *                  games are played out in full, placement included (tester only)
+ *   -l <file>      load a player plugin, or every plugin in a directory (see
+ *                  PlayerPlugins.h); may be given more than once
+ *   -x <command>   add a player that runs in its own process, started with
+ *                  /bin/sh -c command (see EnginePlayer.h); may be repeated
+ *   -t             time every call to the players and print latency
+ *                  histograms with the results
+ *   -m <ms>        a move that takes longer is replaced by a fallback shot;
+ *                  implies -t (see AIContest::setTiming())
+ *   -M <ms>        a player whose calls in one game add up to more forfeits
+ *                  it; implies -t
+ *   -o             compute player 2's move on its own thread while player 1
+ *                  hears its result (see AIContest::setPipelined())
+ *   -T             let USSWhite's fleet targeting sample for a fixed time per
+ *                  shot; games then depend on machine speed and load (see
+ *                  USSWhite::setTimedTargeting())
+ *   -c <file>      read settings from a config file
+ *
+ * Config files hold one "key = value" per line; '#' starts a comment. Keys are
+ * boardSize, games, delay, threads, seed, player1, player2, showAllRounds,
+ * batch, replay, stopError, paired, timing, moveLimit, gameLimit, pipelined,
+ * timedTargeting, plugin and engine (one per line). Flags after -c override
+ * the file.
+ */
+
+#ifndef RUNOPTIONS_H		// Double inclusion protection
+#define RUNOPTIONS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct RunOptions {
+    int boardSize;		// 0 = not given
+    int totalGames;		// 0 = not given
+    float secondsPerMove;	// < 0 = not given
+    int numThreads;
+    uint64_t seed;
+    bool haveSeed;
+    int player1;		// -1 = not given
+    int player2;		// -1 = not given
+    bool showAllRounds;
+    bool batch;
+    string replayFile;		// "" = no replay file
+    double stopError;		// 0 = always play every game
+    bool paired;
+    vector<string> plugins;	// Player plugins to load, in order
+    vector<string> engines;	// Engine commands, in order
+    bool timing;
+    double moveLimit;		// Milliseconds; 0 = no limit
+    double gameLimit;		// Milliseconds; 0 = no limit
+    bool pipelined;
+    bool timedTargeting;	// false = USSWhite's targeting is reproducible
+
+    RunOptions();
+};
+
+/**
+ * @brief Fills in options from argv. Prints a usage message and returns false
+ * on a bad flag or an unreadable config file.
+ */
+bool parseRunOptions( int argc, char* argv[], RunOptions& options );
+
+/**
+ * @brief Reads "key = value" settings from a config file.
+ */
+bool readRunOptionsFile( const string& fileName, RunOptions& options );
+
+/**
+ * @brief Quotes and escapes a string for the JSON summaries.
+ */
+string jsonString( const string& str );
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * ScreenBuffer.cpp: draws the visual games a whole frame at a time.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef SCREENBUFFER_CPP	// Double inclusion protection
+#define SCREENBUFFER_CPP
+
+#include <iostream>
+#include <cerrno>
+#include <unistd.h>
+
+#include "ScreenBuffer.h"
+
+using namespace std;
+using namespace conio;
+
+// A style no cell has: the terminal's style isn't known.
+static const ScreenBuffer::Style UnknownStyle = 0xffffffff;
+
+ScreenBuffer::Style ScreenBuffer::style( Color fg, Color bg ) {
+    return (Style)fg | (Style)bg << 8;
+}
+
+ScreenBuffer::Style ScreenBuffer::style( TextStyle textStyle ) {
+    return (Style)textStyle << 16;
+}
+
+ScreenBuffer::Style ScreenBuffer::style( Color fg, Color bg, TextStyle textStyle ) {
+    return style(fg, bg) | style(textStyle);
+}
+
+ScreenBuffer::ScreenBuffer( int rows, int cols ) {
+    this->rows = rows;
+    this->cols = cols;
+    Cell blankCell = { ' ', 0 };
+    frame.assign(rows*cols, blankCell);
+    shown.assign(rows*cols, blankCell);
+    cleared = true;
+    cursorRow = rows;
+    cursorCol = 1;
+    out.reserve(4096);
+    atRow = atCol = 0;
+    atStyle = UnknownStyle;
+}
+
+void ScreenBuffer::clear() {
+    Cell blankCell = { ' ', 0 };
+    frame.assign(frame.size(), blankCell);
+    cleared = true;
+}
+
+void ScreenBuffer::put( int row, int col, char ch, Style style ) {
+    if( row < 1 || row > rows || col < 1 || col > cols ) return;
+    Cell& cell = frame[(row-1)*cols + col-1];
+    cell.ch = ch;
+    cell.style = style;
+}
+
+void ScreenBuffer::text( int row, int col, const char* str, Style style ) {
+    for( ; *str; str++ ) {
+	put(row, col++, *str, style);
+    }
+}
+
+void ScreenBuffer::text( int row, int col, const string& str, Style style ) {
+    text(row, col, str.c_str(), style);
+}
+
+void ScreenBuffer::number( int row, int col, int n, Style style ) {
+    char digits[12];
+    int length = 0;
+    unsigned int u = n < 0 ? -(unsigned int)n : n;
+    do {
+	digits[length++] = '0' + u % 10;
+	u /= 10;
+    } while( u > 0 );
+    if( n < 0 ) put(row, col++, '-', style);
+    while( length > 0 ) {
+	put(row, col++, digits[--length], style);
+    }
+}
+
+void ScreenBuffer::blank( int row, int col, int count ) {
+    for( int i=0; i<count; i++ ) {
+	put(row, col+i, ' ');
+    }
+}
+
+void ScreenBuffer::setCursor( int row, int col ) {
+    cursorRow = row;
+    cursorCol = col;
+}
+
+void ScreenBuffer::moveTo( int row, int col ) {
+    if( row == atRow && col == atCol ) return;
+    char sequence[MAX_SEQUENCE];
+    out.append(sequence, putRowCol(sequence, row, col));
+    atRow = row;
+    atCol = col;
+}
+
+void ScreenBuffer::setStyle( Style style ) {
+    if( style == atStyle ) return;
+    char sequence[MAX_SEQUENCE];
+    out.append(sequence, putAttributes(sequence, (Color)(style & 0xff),
+				       (Color)(style >> 8 & 0xff), (TextStyle)(style >> 16 & 0xff)));
+    atStyle = style;
+}
+
+void ScreenBuffer::present() {
+    out.clear();
+    // Someone else may have written since the last frame.
+    atRow = atCol = 0;
+    atStyle = UnknownStyle;
+    if( cleared ) {
+	setStyle(0);
+	out += CLEAR_SCREEN;
+	atRow = atCol = 1;
+	Cell blankCell = { ' ', 0 };
+	shown.assign(shown.size(), blankCell);
+	cleared = false;
+    }
+
+    for( int row=1; row<=rows; row++ ) {
+	for( int col=1; col<=cols; col++ ) {
+	    int i = (row-1)*cols + col-1;
+	    if( frame[i] == shown[i] ) continue;
+	    // Over a short gap, repeating what is there is cheaper than a move.
+	    if( row == atRow && col > atCol && col - atCol <= 4 ) {
+		int gap = (row-1)*cols + atCol-1;
+		while( gap < i && shown[gap].style == atStyle ) {
+		    gap++;
+		}
+		if( gap == i ) {
+		    for( gap = (row-1)*cols + atCol-1; gap < i; gap++ ) {
+			out += shown[gap].ch;
+		    }
+		    atCol = col;
+		}
+	    }
+	    moveTo(row, col);
+	    setStyle(frame[i].style);
+	    out += frame[i].ch;
+	    shown[i] = frame[i];
+	    // At the last column the terminal may or may not wrap.
+	    atCol = col < cols ? col+1 : 0;
+	}
+    }
+    if( atStyle != 0 && atStyle != UnknownStyle ) setStyle(0);
+    moveTo(cursorRow, cursorCol);
+
+    cout.flush();
+    const char* data = out.data();
+    size_t left = out.size();
+    while( left > 0 ) {
+	ssize_t written = write(STDOUT_FILENO, data, left);
+	if( written < 0 ) {
+	    if( errno == EINTR ) continue;
+	    break;
+	}
+	data += written;
+	left -= written;
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * ScreenBuffer.h: draws the visual games a whole frame at a time.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The referee draws into a grid of cells (a character and its colors)
+ * instead of onto the terminal. present() compares the grid with what the
+ * terminal already shows, builds the escape sequences for just the cells
+ * that changed, and sends the lot with one write(). Moving the cursor and
+ * changing colors are left out where the terminal is already right, so a
+ * move usually costs a few dozen bytes and the boards never flicker.
+ *
+ * Rows and columns are 1-based, as in conio::gotoRowCol(). Anything drawn
+ * outside the grid is dropped.
+ */
+
+#ifndef SCREENBUFFER_H		// Double inclusion protection
+#define SCREENBUFFER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "conio.h"
+
+using namespace std;
+
+class ScreenBuffer {
+    public:
+	/**
+	 * The colors and style of a cell; 0 is the terminal's default.
+	 */
+	typedef uint32_t Style;
+	static Style style( conio::Color fg, conio::Color bg );
+	static Style style( conio::TextStyle textStyle );
+	static Style style( conio::Color fg, conio::Color bg, conio::TextStyle textStyle );
+
+	ScreenBuffer( int rows, int cols );
+
+	/**
+	 * @brief Blanks the frame. The terminal is cleared too, on the next
+	 * present(), since something else may have written to it meanwhile.
+	 */
+	void clear();
+
+	void put( int row, int col, char ch, Style style = 0 );
+	void text( int row, int col, const char* str, Style style = 0 );
+	void text( int row, int col, const string& str, Style style = 0 );
+
+	/**
+	 * @brief Writes the number n starting at (row, col).
+	 */
+	void number( int row, int col, int n, Style style = 0 );
+
+	/**
+	 * @brief Blanks count cells starting at (row, col).
+	 */
+	void blank( int row, int col, int count );
+
+	/**
+	 * @brief Where present() leaves the cursor, for output that follows.
+	 */
+	void setCursor( int row, int col );
+
+	/**
+	 * @brief Brings the terminal (standard output) up to date with the frame,
+	 * in one write(). Flushes cout first so the two don't interleave.
+	 */
+	void present();
+
+    private:
+	struct Cell {
+	    char ch;
+	    Style style;
+	    bool operator==( const Cell& other ) const {
+		return ch == other.ch && style == other.style;
+	    }
+	};
+
+	void moveTo( int row, int col );
+	void setStyle( Style style );
+
+	int rows;
+	int cols;
+	vector<Cell> frame;	// What is being drawn
+	vector<Cell> shown;	// What the terminal shows
+	bool cleared;		// The terminal must be cleared first
+	int cursorRow;		// Where to leave the cursor
+	int cursorCol;
+
+	// While building the output: where the terminal's cursor is (0 = not
+	// known) and which style it is using. out keeps its capacity, so once
+	// it has grown to a full frame nothing more is allocated.
+	string out;
+	int atRow;
+	int atCol;
+	Style atStyle;
+};
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * SequentialTest.cpp: stops a match once its winner is settled.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef SEQUENTIALTEST_CPP	// Double inclusion protection
+#define SEQUENTIALTEST_CPP
+
+#include <cmath>
+#include <cstdlib>
+
+#include "SequentialTest.h"
+
+using namespace std;
+
+constexpr double SequentialTest::DefaultMargin;
+
+SequentialTest::SequentialTest( double errorRate, double margin ) {
+    this->errorRate = errorRate;
+    if( ! enabled() || margin <= 0 || margin >= 0.5 ) {
+	this->errorRate = 0;
+	margin = DefaultMargin;
+    }
+    winStep = log(1 + 2*margin);
+    lossStep = log(1 - 2*margin);
+    // Half the error rate for each player that could be named.
+    double sideError = this->errorRate / 2;
+    bound = sideError > 0 ? log((1 - sideError) / sideError) : 0;
+}
+
+bool SequentialTest::enabled() {
+    return errorRate > 0 && errorRate < 0.5;
+}
+
+bool SequentialTest::settled( int player1Wins, int player2Wins ) {
+    if( ! enabled() ) return false;
+    return player1Wins * winStep + player2Wins * lossStep >= bound
+	|| player2Wins * winStep + player1Wins * lossStep >= bound;
+}
+
+double SequentialTest::confidence( int player1Wins, int player2Wins ) {
+    int games = player1Wins + player2Wins;
+    if( games == 0 ) return 0.5;
+    double z = abs(player1Wins - player2Wins) / sqrt((double)games);
+    return 0.5 * erfc(-z / sqrt(2.0));
+}
+
+#endif
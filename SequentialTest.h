@@ -0,0 +1,56 @@
+/**
+ * SequentialTest.h: stops a match once its winner is settled.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * A sequential probability ratio test (SPRT) on the decisive games of a
+ * match; ties say nothing about who is better and are left out. For each
+ * player it weighs "the players are even" against "this player wins a
+ * decisive game with chance 1/2 + margin". With w wins for the player and l
+ * for the other, the log likelihood ratio is
+ *     w * ln(1 + 2*margin) + l * ln(1 - 2*margin),
+ * and the match is settled once either player's passes
+ * ln((1 - errorRate/2) / (errorRate/2)). Between even players a winner is
+ * named with chance at most errorRate; a player margin better is usually
+ * found quickly. Players that stay close play all their games, as before.
+ *
+ * confidence() is for reports: the chance, by the normal approximation to
+ * the sign test, that the player ahead would stay ahead over many games.
+ */
+
+#ifndef SEQUENTIALTEST_H	// Double inclusion protection
+#define SEQUENTIALTEST_H
+
+class SequentialTest {
+    public:
+	/**
+	 * @param errorRate Chance of naming the wrong winner; 0 turns the test off.
+	 * @param margin How far from even a player must be to count as better.
+	 */
+	SequentialTest( double errorRate = 0, double margin = DefaultMargin );
+
+	bool enabled();
+
+	/**
+	 * @brief Whether the match can stop, given each player's wins so far.
+	 * Always false when the test is off.
+	 */
+	bool settled( int player1Wins, int player2Wins );
+
+	/**
+	 * @brief How sure the wins make us that the player ahead is the better
+	 * one, from 0.5 (level) to 1.
+	 */
+	static double confidence( int player1Wins, int player2Wins );
+
+	// A 55-45 split of decisive games.
+	constexpr static double DefaultMargin = 0.05;
+
+    private:
+	double errorRate;
+	double winStep;		// Log likelihood ratio added by a win,
+	double lossStep;	// and by a loss (negative).
+	double bound;
+};
+
+#endif
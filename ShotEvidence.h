@@ -0,0 +1,36 @@
+/**
+ * ShotEvidence.h: what a player knows about the opponent's board.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * This is the input to the targeting engines (ShotSampler, ...). A fleet
+ * configuration is consistent with the evidence when its ships are the
+ * ships still afloat, none of them overlaps a miss, a sunk ship or another
+ * ship, and together they cover every unsunk hit.
+ */
+
+#ifndef SHOTEVIDENCE_H		// Double inclusion protection
+#define SHOTEVIDENCE_H
+
+#include "defines.h"
+#include "CellMask.h"
+
+const int MaxFleetShips = 16;
+
+struct ShotEvidence {
+    int boardSize;
+    CellMask misses;			// Shots that missed.
+    CellMask hits;			// Hits on ships that are still afloat.
+    CellMask sunk;			// Cells of sunk ships.
+    int numShips;			// Ships still afloat ...
+    int shipLengths[MaxFleetShips];	// ... and their lengths.
+};
+
+/**
+ * @brief Cells that have not been shot at yet.
+ */
+inline CellMask unshotCells( const ShotEvidence& evidence, CellMask boardCells ) {
+    return boardCells & ~(evidence.misses | evidence.hits | evidence.sunk);
+}
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * ShotSampler.cpp: Monte Carlo targeting from sampled fleet configurations.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef SHOTSAMPLER_CPP		// Double inclusion protection
+#define SHOTSAMPLER_CPP
+
+#include <chrono>
+#include <vector>
+
+#include "ShotSampler.h"
+#include "ThreadPool.h"
+#include "ThreadRandom.h"
+
+using namespace std;
+
+// Tries at a free spot for one ship before the sample is given up.
+const int PlacementTries = 16;
+// Samples between clock reads.
+const int SamplesPerClockCheck = 16;
+
+static long long nowMicroseconds() {
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// splitmix64: small, fast and good enough for picking placements.
+static inline uint64_t nextRandom( uint64_t& state ) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline int randomBelow( uint64_t& state, int n ) {
+    return (int)(((nextRandom(state) >> 32) * (uint64_t)n) >> 32);
+}
+
+ShotSampler::ShotSampler( int timeBudgetMicroseconds, int numThreads, long maxSamples ) {
+    this->timeBudgetMicroseconds = timeBudgetMicroseconds;
+    this->numThreads = numThreads < 1 ? 1 : numThreads;
+    this->maxSamples = maxSamples;
+    this->tried = 0;
+    this->pool = this->numThreads > 1 ? new ThreadPool(this->numThreads - 1) : NULL;
+}
+
+ShotSampler::~ShotSampler() {
+    delete pool;
+}
+
+void ShotSampler::findCandidates( const ShotEvidence& evidence ) {
+    blocked = evidence.misses | evidence.sunk | outsideBoard(evidence.boardSize);
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	candidates.count[length] = 0;
+    }
+    for( int i=0; i<evidence.numShips; i++ ) {
+	int length = evidence.shipLengths[i];
+	if( length < 1 || length > MAX_SHIP_SIZE || candidates.count[length] > 0 ) continue;
+	for( int horiz=0; horiz<2; horiz++ ) {
+	    for( int row=0; row<evidence.boardSize; row++ ) {
+		for( int col=0; col<evidence.boardSize; col++ ) {
+		    CellMask ship = placementMask(length, horiz, row, col);
+		    if( (ship & blocked) == 0 ) {
+			candidates.placements[length][candidates.count[length]++] = ship;
+		    }
+		}
+	    }
+	}
+    }
+}
+
+/**
+ * Picks a random placement of a ship of the given length over cell, clear of
+ * the blocked and occupied cells. Returns 0 if there is none.
+ */
+CellMask ShotSampler::placementCovering( int cell, int length, CellMask occupied, uint64_t& state ) {
+    if( length < 1 || length > MAX_SHIP_SIZE ) return 0;
+    int row = cell / CellMaskStride;
+    int col = cell % CellMaskStride;
+    CellMask options[2*MAX_SHIP_SIZE];
+    int count = 0;
+    for( int i=0; i<length; i++ ) {
+	if( col-i >= 0 ) {
+	    CellMask ship = placementMask(length, true, row, col-i);
+	    if( (ship & (blocked | occupied)) == 0 ) options[count++] = ship;
+	}
+	if( row-i >= 0 ) {
+	    CellMask ship = placementMask(length, false, row-i, col);
+	    if( (ship & (blocked | occupied)) == 0 ) options[count++] = ship;
+	}
+    }
+    return count > 0 ? options[randomBelow(state, count)] : 0;
+}
+
+long ShotSampler::placementsTried() {
+    return tried;
+}
+
+long ShotSampler::sample( const ShotEvidence& evidence, uint64_t seed, long cellHits[CellCountSize] ) {
+    for( int i=0; i<CellCountSize; i++ ) {
+	cellHits[i] = 0;
+    }
+    tried = 0;
+    if( evidence.numShips < 1 || evidence.numShips > MaxFleetShips ) {
+	return 0;
+    }
+    findCandidates(evidence);
+
+    // Untimed runs never reach the deadline; the attempt limit stops them.
+    long long deadline = timeBudgetMicroseconds > 0 ? nowMicroseconds() + timeBudgetMicroseconds : 0;
+    if( ! pool ) {
+	return sampleOnThisThread(evidence, seed, deadline, maxSamples, cellHits, tried);
+    }
+
+    // Every thread samples its own stream until the deadline; then add them up.
+    vector< vector<long> > helperHits(numThreads-1, vector<long>(CellCountSize, 0));
+    vector<long> helperSamples(numThreads-1, 0);
+    vector<long> helperTried(numThreads-1, 0);
+    long capPerThread = maxSamples > 0 ? (maxSamples + numThreads-1) / numThreads : 0;
+    for( int t=1; t<numThreads; t++ ) {
+	long* hits = &helperHits[t-1][0];
+	long* samples = &helperSamples[t-1];
+	long* threadTried = &helperTried[t-1];
+	uint64_t threadSeed = threadRandom::deriveSeed(seed, t);
+	pool->submit( [this, &evidence, threadSeed, deadline, capPerThread, hits, samples, threadTried]() {
+	    *samples = sampleOnThisThread(evidence, threadSeed, deadline, capPerThread, hits, *threadTried);
+	} );
+    }
+    long kept = sampleOnThisThread(evidence, seed, deadline, capPerThread, cellHits, tried);
+    pool->wait();
+    for( int t=1; t<numThreads; t++ ) {
+	kept += helperSamples[t-1];
+	tried += helperTried[t-1];
+	for( int i=0; i<CellCountSize; i++ ) {
+	    cellHits[i] += helperHits[t-1][i];
+	}
+    }
+    return kept;
+}
+
+long ShotSampler::sampleOnThisThread( const ShotEvidence& evidence, uint64_t seed, long long deadline,
+                                      long maxSamples, long cellHits[CellCountSize], long& drawn ) {
+    CellMask unshot = unshotCells(evidence, placementTable.board[evidence.boardSize]);
+    int order[MaxFleetShips];
+    for( int i=0; i<evidence.numShips; i++ ) {
+	order[i] = evidence.shipLengths[i];
+    }
+
+    uint64_t state = seed;
+    long kept = 0;
+    long maxAttempts = deadline == 0 ? maxSamples * MaxAttemptsPerSample : 0;
+    for( long attempt=0; ; attempt++ ) {
+	if( maxSamples > 0 && kept >= maxSamples ) break;
+	if( deadline == 0 ) {
+	    if( attempt >= maxAttempts ) break;
+	} else if( attempt % SamplesPerClockCheck == 0 && nowMicroseconds() >= deadline ) {
+	    break;
+	}
+
+	// Shuffle the placing order so no ship always gets first pick.
+	for( int i=evidence.numShips-1; i>0; i-- ) {
+	    int j = randomBelow(state, i+1);
+	    int length = order[i];
+	    order[i] = order[j];
+	    order[j] = length;
+	}
+
+	CellMask occupied = 0;
+	bool placedAll = true;
+	for( int i=0; i<evidence.numShips && placedAll; i++ ) {
+	    int length = order[i];
+	    CellMask uncovered = evidence.hits & ~occupied;
+	    if( uncovered != 0 ) {
+		// Cover the first uncovered hit with this ship, or most samples would miss the hits.
+		CellMask ship = placementCovering(firstCell(uncovered), length, occupied, state);
+		drawn++;
+		occupied |= ship;
+		placedAll = ship != 0;
+		continue;
+	    }
+	    int count = length >= 1 && length <= MAX_SHIP_SIZE ? candidates.count[length] : 0;
+	    placedAll = false;
+	    for( int tries=0; tries<PlacementTries && count > 0; tries++ ) {
+		CellMask ship = candidates.placements[length][randomBelow(state, count)];
+		drawn++;
+		if( (ship & occupied) == 0 ) {
+		    occupied |= ship;
+		    placedAll = true;
+		    break;
+		}
+	    }
+	}
+	if( ! placedAll || (evidence.hits & ~occupied) != 0 ) {
+	    continue;
+	}
+
+	kept++;
+	for( CellMask cells = occupied & unshot; cells != 0; cells &= cells - 1 ) {
+	    cellHits[firstCell(cells)]++;
+	}
+    }
+    return kept;
+}
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * ShotSampler.h: Monte Carlo targeting from sampled fleet configurations.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Each sample places the ships still afloat at random, one at a time in a
+ * random order, each on a placement that avoids misses, sunk ships, the
+ * board edge and the ships already placed. While some unsunk hit is not yet
+ * covered, the next ship is put over it; a sample whose ships cannot all be
+ * placed is thrown away. This is not an exact draw from the posterior, but it
+ * is close, and it keeps nearly every sample once hits are on the board. Over the kept samples, how often a ship covers
+ * an unshot cell estimates the chance that the cell is a hit.
+ *
+ * Sampling stops when the time budget or the sample cap runs out, whichever
+ * comes first. With more than one thread the budget is spent on every thread
+ * at once and the counts are added up. With no time budget the clock is never
+ * read: sampling stops at the cap or after MaxAttemptsPerSample attempts per
+ * sample wanted, so the same seed always gives the same counts.
+ */
+
+#ifndef SHOTSAMPLER_H		// Double inclusion protection
+#define SHOTSAMPLER_H
+
+#include <cstdint>
+
+#include "ShotEvidence.h"
+#include "PlacementTable.h"
+
+class ThreadPool;
+
+// Counts per cell, indexed by CellMask bit number (row*CellMaskStride + col).
+const int CellCountSize = 128;
+
+// Attempts allowed per sample wanted when sampling without a time budget.
+const int MaxAttemptsPerSample = 8;
+
+class ShotSampler {
+    public:
+	/**
+	 * @param timeBudgetMicroseconds Time to spend per call to sample(); 0 for
+	 * no time limit, which needs a sample cap.
+	 * @param numThreads Threads to sample on, counting the caller.
+	 * @param maxSamples Stop after this many kept samples (0 = no cap).
+	 */
+	ShotSampler( int timeBudgetMicroseconds, int numThreads = 1, long maxSamples = 0 );
+	~ShotSampler();
+
+	/**
+	 * @brief Samples configurations consistent with the evidence.
+	 * @param seed Seeds the sampling; the same seed and the same number of
+	 * attempts give the same counts.
+	 * @param cellHits Set to the number of kept samples with a ship on each
+	 * unshot cell (0 for cells already shot).
+	 * @return The number of kept samples; 0 if none were found in time.
+	 */
+	long sample( const ShotEvidence& evidence, uint64_t seed, long cellHits[CellCountSize] );
+
+	/**
+	 * @brief Ship placements drawn by the last sample(), over all threads: the
+	 * work it did, counted the same way as PlacementCounter::placementsTried().
+	 */
+	long placementsTried();
+
+    private:
+	// Where each ship length can go, given the misses and sunk ships.
+	struct Candidates {
+	    CellMask placements[MAX_SHIP_SIZE+1][2*MAX_BOARD_SIZE*MAX_BOARD_SIZE];
+	    int count[MAX_SHIP_SIZE+1];
+	};
+
+	void findCandidates( const ShotEvidence& evidence );
+	CellMask placementCovering( int cell, int length, CellMask occupied, uint64_t& state );
+	long sampleOnThisThread( const ShotEvidence& evidence, uint64_t seed, long long deadline,
+	                         long maxSamples, long cellHits[CellCountSize], long& drawn );
+
+	Candidates candidates;
+	CellMask blocked;	// Misses, sunk ships and the cells off the board.
+	int timeBudgetMicroseconds;
+	int numThreads;
+	long maxSamples;
+	long tried;		// Placements drawn by the last sample().
+	ThreadPool* pool;	// numThreads-1 helpers, or NULL
+
+	// Not copyable.
+	ShotSampler( const ShotSampler& );
+	void operator=( const ShotSampler& );
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * SmallBoard.h: bitboard BoardV3 for boards up to MAX_BOARD_SIZE.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Ships, shots and sunk ships are CellMasks (see CellMask.h). The views are
+ * derived from the masks on demand:
+ *   - unshot ship cell:  its ship mark ('a', 'b', ...) for the owner, WATER otherwise
+ *   - shot water:        MISS
+ *   - shot ship cell:    HIT, or KILL once every cell of that ship has been shot
+ *
+ * The board size is a template parameter, so the bounds checks compare with
+ * constants and the cells outside the board are a constant mask, built at
+ * compile time. BoardV3::create() makes one SmallBoard per size.
+ */
+
+#ifndef SMALLBOARD_H		// Double inclusion protection
+#define SMALLBOARD_H
+
+#include <iostream>
+
+#include "BoardV3.h"
+#include "CellMask.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+/**
+ * Every bit that is not a cell of a size x size board.
+ */
+constexpr CellMask cellsOutside( int size ) {
+    CellMask board = 0;
+    for( int row=0; row<size; row++ ) {
+	for( int col=0; col<size; col++ ) {
+	    board |= cellBit(row, col);
+	}
+    }
+    return ~board;
+}
+
+template<int Size>
+class SmallBoard : public BoardV3 {
+    public:
+	SmallBoard();
+
+	void clear();
+	bool placeShip(int row, int col, int length, Direction dir);
+	char getOpponentView(int row, int col);
+	char getOwnerView(int row, int col);
+	char getShipMark(int row, int col);
+	char processShot(int row, int col);
+	bool hasWon();
+	ShipLocation getShip(int row, int col);
+
+	static_assert(Size >= 1 && Size <= MAX_BOARD_SIZE, "SmallBoard holds up to MAX_BOARD_SIZE x MAX_BOARD_SIZE");
+	constexpr static CellMask OutsideCells = cellsOutside(Size);
+
+    private:
+	bool positionOk(int row, int col, int length, bool horiz);
+	void markShip(int row, int col, int length, bool horiz);
+
+	CellMask shipCells;		// Every cell covered by a ship.
+	CellMask shotCells;		// Every cell that has been shot at.
+	CellMask sunkCells;		// Cells of ships that have been sunk.
+	CellMask shipMasks[MaxShips];	// Cells of each ship, in placement order.
+	ShipLocation ships[MaxShips];	// Where each ship is, in placement order.
+	char shipIndex[Size*CellMaskStride];	// Ship number at each cell.
+	int numShips;
+};
+
+template<int Size>
+constexpr CellMask SmallBoard<Size>::OutsideCells;
+
+template<int Size>
+SmallBoard<Size>::SmallBoard() {
+    clear();
+}
+
+// shipIndex and ships are only read for cells in shipCells, so they can stay.
+template<int Size>
+void SmallBoard<Size>::clear() {
+    numShips = 0;
+    shipCells = 0;
+    shotCells = 0;
+    sunkCells = 0;
+}
+
+/**
+ * Places a ship with its top/left end at row, col. Any direction other than
+ * Horizontal is treated as Vertical.
+ * @return false if the ship would leave the board or overlap another ship.
+ */
+template<int Size>
+bool SmallBoard<Size>::placeShip( int row, int col, int length, Direction dir ) {
+    bool horiz = dir == Horizontal;
+    if( ! positionOk(row, col, length, horiz) ) {
+	return false;
+    }
+    markShip(row, col, length, horiz);
+    return true;
+}
+
+template<int Size>
+bool SmallBoard<Size>::positionOk( int row, int col, int length, bool horiz ) {
+    // Usual case: on the board and clear of other ships, in one AND.
+    if( numShips < MaxShips && (placementMask(length, horiz, row, col) & (shipCells | OutsideCells)) == 0 ) {
+	return true;
+    }
+
+    // Otherwise work out what is wrong, for the message.
+    if( horiz ) {
+	if( row < 0 || row >= Size || col < 0 || col+length-1 >= Size ) {
+	    cerr << "positionOk: horizontal position invalid" << endl;
+	    return false;
+	}
+    } else {
+	if( col < 0 || col >= Size || row < 0 || row+length-1 >= Size ) {
+	    cerr << "positionOk: vertical position invalid" << endl;
+	    return false;
+	}
+    }
+    if( numShips >= MaxShips ) {
+	cerr << "positionOk: too many ships" << endl;
+	return false;
+    }
+
+    for( int i=0; i<length; i++ ) {
+	int r = horiz ? row : row+i;
+	int c = horiz ? col+i : col;
+	if( hasCell(shipCells, r, c) ) {
+	    cerr << "positionOk: horizontal collision at row=" << r << ", col=" << c << endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+template<int Size>
+void SmallBoard<Size>::markShip( int row, int col, int length, bool horiz ) {
+    bool inTable = length >= 1 && length <= MAX_SHIP_SIZE;
+    CellMask ship = inTable ? placementMask(length, horiz, row, col) : 0;
+    for( int i=0; i<length; i++ ) {
+	int r = horiz ? row : row+i;
+	int c = horiz ? col+i : col;
+	if( ! inTable ) ship |= cellBit(r, c);
+	shipIndex[r*CellMaskStride + c] = numShips;
+    }
+    ShipLocation location = { row, col, length, horiz ? Horizontal : Vertical, numShips };
+    ships[numShips] = location;
+    shipMasks[numShips++] = ship;
+    shipCells |= ship;
+}
+
+template<int Size>
+char SmallBoard<Size>::getOpponentView( int row, int col ) {
+    if( ! hasCell(shotCells, row, col) ) return WATER;
+    if( hasCell(sunkCells, row, col) ) return KILL;
+    return hasCell(shipCells, row, col) ? HIT : MISS;
+}
+
+template<int Size>
+char SmallBoard<Size>::getOwnerView( int row, int col ) {
+    if( hasCell(shipCells, row, col) && ! hasCell(shotCells, row, col) ) {
+	return getShipMark(row, col);
+    }
+    return getOpponentView(row, col);
+}
+
+template<int Size>
+char SmallBoard<Size>::getShipMark( int row, int col ) {
+    if( ! hasCell(shipCells, row, col) ) return WATER;
+    return 'a' + shipIndex[row*CellMaskStride + col];
+}
+
+/**
+ * Shoots at row, col.
+ * @return MISS, HIT, KILL (the shot sank the ship), DUPLICATE_SHOT, or
+ * INVALID_SHOT for a shot off the board.
+ */
+template<int Size>
+char SmallBoard<Size>::processShot( int row, int col ) {
+    if( row < 0 || row >= Size || col < 0 || col >= Size ) {
+	return INVALID_SHOT;
+    }
+    CellMask cell = cellBit(row, col);
+    if( shotCells & cell ) {
+	return DUPLICATE_SHOT;
+    }
+    shotCells |= cell;
+    if( ! (shipCells & cell) ) {
+	return MISS;
+    }
+
+    CellMask ship = shipMasks[(int)shipIndex[row*CellMaskStride + col]];
+    if( ship & ~shotCells ) {
+	return HIT;
+    }
+    sunkCells |= ship;
+    return KILL;
+}
+
+template<int Size>
+bool SmallBoard<Size>::hasWon() {
+    return (shipCells & ~shotCells) == 0;
+}
+
+template<int Size>
+ShipLocation SmallBoard<Size>::getShip( int row, int col ) {
+    if( ! hasCell(shipCells, row, col) ) {
+	ShipLocation none = { row, col, 0, None, -1 };
+	return none;
+    }
+    return ships[(int)shipIndex[row*CellMaskStride + col]];
+}
+
+#endif
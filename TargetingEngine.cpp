@@ -0,0 +1,106 @@
+/**
+ * TargetingEngine.cpp: picks the faster of the exact and sampled hit estimates.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef TARGETINGENGINE_CPP	// Double inclusion protection
+#define TARGETINGENGINE_CPP
+
+#include <chrono>
+#include <cmath>
+
+#include "TargetingEngine.h"
+#include "PlacementTable.h"
+
+using namespace std;
+
+const char* targetingMethodNames[NumTargetingMethods] = { "sampled", "exact" };
+
+// Exact counts to time in each phase before the averages are trusted.
+const int TrialRuns = 3;
+// Calls in a phase between exact counts when the sampler is winning.
+const int RetryInterval = 64;
+// Weight of the newest time in the running averages.
+const double NewTimeWeight = 0.125;
+
+TargetingEngine::TargetingEngine( int samplerBudgetMicroseconds, int samplerThreads, long maxSamples, int exactMaxStates )
+    : sampler(samplerBudgetMicroseconds, samplerThreads, maxSamples),
+      counter(exactMaxStates)
+{
+    timed = samplerBudgetMicroseconds > 0;
+    for( int p=0; p<NumPhases; p++ ) {
+	phases[p].calls = 0;
+	for( int m=0; m<NumTargetingMethods; m++ ) {
+	    phases[p].meanCost[m] = 0;
+	    phases[p].runs[m] = 0;
+	}
+	// Until it has been run, the sampler is assumed to use its whole budget;
+	// untimed, it only gets a turn once an exact count has given up.
+	phases[p].meanCost[SampledTargeting] = timed ? samplerBudgetMicroseconds : HUGE_VAL;
+    }
+    method = SampledTargeting;
+}
+
+TargetingMethod TargetingEngine::lastMethod() {
+    return method;
+}
+
+int TargetingEngine::phaseOf( const ShotEvidence& evidence ) {
+    int cells = evidence.boardSize * evidence.boardSize;
+    int shot = cellCount(evidence.misses | evidence.hits | evidence.sunk);
+    int phase = cells > 0 ? shot * NumPhases / cells : 0;
+    return phase < NumPhases ? phase : NumPhases-1;
+}
+
+TargetingMethod TargetingEngine::choose( int phase ) {
+    PhaseStats& stats = phases[phase];
+    stats.calls++;
+    if( stats.runs[ExactTargeting] < TrialRuns || stats.calls % RetryInterval == 0 ) {
+	return ExactTargeting;
+    }
+    return stats.meanCost[ExactTargeting] < stats.meanCost[SampledTargeting]
+	 ? ExactTargeting : SampledTargeting;
+}
+
+void TargetingEngine::record( int phase, TargetingMethod method, double cost ) {
+    PhaseStats& stats = phases[phase];
+    double& mean = stats.meanCost[method];
+    int runs = ++stats.runs[method];
+    if( runs == 1 ) {
+	mean = cost;
+	return;
+    }
+    // Plain average over the first few runs, then a running average.
+    double weight = runs < 1.0/NewTimeWeight ? 1.0/runs : NewTimeWeight;
+    mean += (cost - mean) * weight;
+}
+
+static double microsecondsSince( chrono::steady_clock::time_point start ) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+bool TargetingEngine::cellWeights( const ShotEvidence& evidence, uint64_t seed, double cellWeights[CellCountSize] ) {
+    int phase = phaseOf(evidence);
+    if( choose(phase) == ExactTargeting ) {
+	chrono::steady_clock::time_point start = timed ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+	bool counted = counter.count(evidence, cellWeights);
+	record(phase, ExactTargeting, timed ? microsecondsSince(start) : counter.placementsTried());
+	if( counted ) {
+	    method = ExactTargeting;
+	    return true;
+	}
+    }
+
+    chrono::steady_clock::time_point start = timed ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+    long cellHits[CellCountSize];
+    long samples = sampler.sample(evidence, seed, cellHits);
+    record(phase, SampledTargeting, timed ? microsecondsSince(start) : sampler.placementsTried());
+    for( int i=0; i<CellCountSize; i++ ) {
+	cellWeights[i] = cellHits[i];
+    }
+    method = SampledTargeting;
+    return samples > 0;
+}
+
+#endif
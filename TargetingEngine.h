@@ -0,0 +1,74 @@
+/**
+ * TargetingEngine.h: picks the faster of the exact and sampled hit estimates.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * PlacementCounter gives exact chances but is only quick once the board has
+ * filled up; ShotSampler always takes about its time budget. The engine keeps
+ * the average time each one has taken in each game phase (tenths of the board
+ * shot at) and uses whichever has been faster there. An exact count that
+ * gives up is charged to the exact engine and the sampler is run instead.
+ * The exact engine is tried a few times in every phase before it can lose,
+ * and again now and then in case the games have changed.
+ *
+ * With no sampler time budget the engine never reads the clock: it compares
+ * the ship placements each engine looked at instead of the time taken, so its
+ * choices, and the weights, depend only on the evidence and the seed.
+ */
+
+#ifndef TARGETINGENGINE_H	// Double inclusion protection
+#define TARGETINGENGINE_H
+
+#include <cstdint>
+
+#include "ShotEvidence.h"
+#include "ShotSampler.h"
+#include "PlacementCounter.h"
+
+enum TargetingMethod { SampledTargeting=0, ExactTargeting, NumTargetingMethods };
+
+extern const char* targetingMethodNames[NumTargetingMethods];
+
+class TargetingEngine {
+    public:
+	/**
+	 * @param samplerBudgetMicroseconds, samplerThreads, maxSamples See ShotSampler;
+	 * a budget of 0 makes the engine reproducible.
+	 * @param exactMaxStates See PlacementCounter.
+	 */
+	TargetingEngine( int samplerBudgetMicroseconds, int samplerThreads, long maxSamples, int exactMaxStates );
+
+	/**
+	 * @brief Sets cellWeights to numbers proportional to the chance that each
+	 * unshot cell holds a ship (0 for cells already shot).
+	 * @param seed Seeds the sampler, if it is used.
+	 * @return false if neither engine found a configuration that fits.
+	 */
+	bool cellWeights( const ShotEvidence& evidence, uint64_t seed, double cellWeights[CellCountSize] );
+
+	/**
+	 * @brief The engine that produced the last weights.
+	 */
+	TargetingMethod lastMethod();
+
+	const static int NumPhases = 10;
+
+    private:
+	struct PhaseStats {
+	    double meanCost[NumTargetingMethods];	// Microseconds, or placements if untimed.
+	    int runs[NumTargetingMethods];
+	    int calls;
+	};
+
+	int phaseOf( const ShotEvidence& evidence );
+	TargetingMethod choose( int phase );
+	void record( int phase, TargetingMethod method, double cost );
+
+	ShotSampler sampler;
+	PlacementCounter counter;
+	PhaseStats phases[NumPhases];
+	TargetingMethod method;
+	bool timed;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * ThreadPool.cpp: a small fixed-size pool of worker threads.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef THREADPOOL_CPP		// Double inclusion protection
+#define THREADPOOL_CPP
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool( int numThreads ) {
+    activeJobs = 0;
+    stopping = false;
+    if( numThreads < 1 ) {
+	numThreads = 1;
+    }
+    for( int i=0; i<numThreads; i++ ) {
+	workers.push_back( thread(&ThreadPool::workerLoop, this) );
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+	unique_lock<mutex> guard(lock);
+	stopping = true;
+    }
+    jobAvailable.notify_all();
+    for( size_t i=0; i<workers.size(); i++ ) {
+	workers[i].join();
+    }
+}
+
+void ThreadPool::submit( function<void()> job ) {
+    {
+	unique_lock<mutex> guard(lock);
+	jobs.push_back(job);
+	activeJobs++;
+    }
+    jobAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(lock);
+    while( activeJobs > 0 ) {
+	allDone.wait(guard);
+    }
+}
+
+int ThreadPool::size() {
+    return (int)workers.size();
+}
+
+void ThreadPool::workerLoop() {
+    while( true ) {
+	function<void()> job;
+	{
+	    unique_lock<mutex> guard(lock);
+	    while( jobs.empty() && ! stopping ) {
+		jobAvailable.wait(guard);
+	    }
+	    if( jobs.empty() ) {
+		return;		// Stopping and nothing left to do.
+	    }
+	    job = jobs.front();
+	    jobs.pop_front();
+	}
+
+	job();
+
+	unique_lock<mutex> guard(lock);
+	activeJobs--;
+	if( activeJobs == 0 ) {
+	    allDone.notify_all();
+	}
+    }
+}
+
+#endif
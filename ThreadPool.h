@@ -0,0 +1,50 @@
+/**
+ * ThreadPool.h: a small fixed-size pool of worker threads.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef THREADPOOL_H		// Double inclusion protection
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool {
+    public:
+	ThreadPool( int numThreads );
+	~ThreadPool();
+
+	/**
+	 * @brief Queues a job. Jobs are started in the order they are submitted.
+	 */
+	void submit( function<void()> job );
+
+	/**
+	 * @brief Blocks until every submitted job has finished.
+	 */
+	void wait();
+
+	int size();
+
+    private:
+	ThreadPool( const ThreadPool& );
+	void operator=( const ThreadPool& );
+	void workerLoop();
+
+	vector<thread> workers;
+	deque< function<void()> > jobs;
+	mutex lock;
+	condition_variable jobAvailable;
+	condition_variable allDone;
+	int activeJobs;
+	bool stopping;
+};
+
+#endif
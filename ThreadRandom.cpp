@@ -0,0 +1,92 @@
+/**
+ * ThreadRandom.cpp: per-thread rand()/srand()/random()/srandom().
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Linking this file into a program makes the C library random functions
+ * thread-local. Each thread owns a random_r() state that is initialized the
+ * same way glibc initializes its global state, so the numbers produced after
+ * srand(seed) are identical to the ones the C library would produce.
+ */
+
+#ifndef THREADRANDOM_CPP		// Double inclusion protection
+#define THREADRANDOM_CPP
+
+#include <cstdlib>
+#include <cstring>
+
+#include "ThreadRandom.h"
+
+using namespace std;
+
+namespace {
+
+    // glibc's rand() uses a TYPE_3 generator: 128 bytes of state.
+    const int StateBytes = 128;
+
+    struct ThreadState {
+	struct random_data data;
+	char state[StateBytes];
+	bool seeded;
+    };
+
+    thread_local ThreadState threadState;
+
+    void seedState( ThreadState& ts, unsigned int seed ) {
+	memset(&ts.data, 0, sizeof ts.data);
+	initstate_r(seed, ts.state, StateBytes, &ts.data);
+	ts.seeded = true;
+    }
+
+    int nextValue() {
+	ThreadState& ts = threadState;
+	// An unseeded generator behaves as if srand(1) had been called.
+	if( ! ts.seeded ) {
+	    seedState(ts, 1);
+	}
+	int32_t value;
+	random_r(&ts.data, &value);
+	return value;
+    }
+}
+
+namespace threadRandom {
+
+    uint64_t deriveSeed( uint64_t seed, uint64_t a, uint64_t b, uint64_t c ) {
+	// splitmix64 finalizer applied once per component.
+	uint64_t values[3] = { a, b, c };
+	uint64_t z = seed;
+	for( int i=0; i<3; i++ ) {
+	    z += 0x9E3779B97F4A7C15ULL + values[i];
+	    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	    z = z ^ (z >> 31);
+	}
+	return z;
+    }
+
+    void seed( uint64_t seed ) {
+	seedState(threadState, (unsigned int)seed);
+    }
+}
+
+extern "C" {
+
+    int rand( void ) throw() {
+	return nextValue();
+    }
+
+    void srand( unsigned int seed ) throw() {
+	seedState(threadState, seed);
+    }
+
+    long random( void ) throw() {
+	return nextValue();
+    }
+
+    void srandom( unsigned int seed ) throw() {
+	seedState(threadState, seed);
+    }
+}
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * ThreadRandom.h: per-thread replacement for the C library random number generator.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * The provided player binaries (CleanPlayerV2.o, GamblerPlayerV2.o, ...) call
+ * rand() and random() directly, and the C library keeps a single generator for
+ * the whole process. ThreadRandom.cpp defines rand(), srand(), random() and
+ * srandom() itself so that every thread gets its own generator. The sequence a
+ * thread sees after srand(seed) is exactly the sequence the C library would
+ * give after the same call, so a single-threaded run behaves as before.
+ */
+
+#ifndef THREADRANDOM_H		// Double inclusion protection
+#define THREADRANDOM_H
+
+#include <cstdint>
+
+namespace threadRandom {
+
+    /**
+     * \brief Mixes a tournament seed with up to three indices into a new seed.
+     * Used to give each pairing (and each round block inside a pairing) an
+     * independent, reproducible random number stream.
+     */
+    uint64_t deriveSeed( uint64_t seed, uint64_t a, uint64_t b = 0, uint64_t c = 0 );
+
+    /**
+     * \brief Seeds the calling thread's generator (same as srand()).
+     */
+    void seed( uint64_t seed );
+}
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * TimedPlayer.cpp: wraps a player and records how long each call takes.
+ * @author Mitchell Toth
+ * @date October, 2026
+ */
+
+#ifndef TIMEDPLAYER_CPP		// Double inclusion protection
+#define TIMEDPLAYER_CPP
+
+#include <chrono>
+#include <sstream>
+
+#include "TimedPlayer.h"
+#include "AllocCounter.h"
+
+using namespace std;
+
+const char* playerCallNames[NumPlayerCalls] = { "newRound", "getMove", "update", "placeShip" };
+
+static long long nowNanoseconds() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+CallStats::CallStats() {
+    totalNanoseconds = 0;
+    totalAllocations = 0;
+}
+
+void CallStats::add( long long nanoseconds, long long allocations ) {
+    latencies.record(nanoseconds);
+    totalNanoseconds += nanoseconds;
+    totalAllocations += allocations;
+}
+
+long long CallStats::count() const {
+    return latencies.count();
+}
+
+long long CallStats::allocations() const {
+    return totalAllocations;
+}
+
+double CallStats::mean() const {
+    return count() == 0 ? 0 : double(totalNanoseconds) / count();
+}
+
+long long CallStats::percentile( double percent ) const {
+    return percent >= 100 ? latencies.max() : latencies.percentile(percent);
+}
+
+string CallStats::toJson() const {
+    ostringstream out;
+    out << "{\"count\":" << count() << ",\"mean\":" << (long long)(mean() + 0.5)
+	<< ",\"p50\":" << percentile(50) << ",\"p90\":" << percentile(90)
+	<< ",\"p99\":" << percentile(99) << ",\"max\":" << percentile(100)
+	<< ",\"allocs\":" << allocations() << "}";
+    return out.str();
+}
+
+TimedPlayer::TimedPlayer( PlayerV2* player, int boardSize, CallStats* stats )
+    :PlayerV3(boardSize)
+{
+    this->player = player;
+    this->playerV3 = dynamic_cast<PlayerV3*>(player);
+    this->stats = stats;
+}
+
+TimedPlayer::~TimedPlayer() {
+    delete player;
+}
+
+void TimedPlayer::newRound() {
+    long long allocs = allocationCount();
+    long long start = nowNanoseconds();
+    player->newRound();
+    long long elapsed = nowNanoseconds() - start;
+    stats[NewRoundCall].add(elapsed, allocationCount() - allocs);
+}
+
+Move TimedPlayer::nextMove() {
+    Move move;
+    long long allocs = allocationCount();
+    long long start = nowNanoseconds();
+    if( playerV3 ) {
+	move = playerV3->nextMove();
+    } else {
+	Message msg = player->getMove();
+	move = toMove(msg);
+    }
+    long long elapsed = nowNanoseconds() - start;
+    stats[GetMoveCall].add(elapsed, allocationCount() - allocs);
+    return move;
+}
+
+void TimedPlayer::notify( Move move ) {
+    long long allocs = allocationCount();
+    long long start = nowNanoseconds();
+    if( playerV3 ) {
+	playerV3->notify(move);
+    } else {
+	player->update(toMessage(move));
+    }
+    long long elapsed = nowNanoseconds() - start;
+    stats[UpdateCall].add(elapsed, allocationCount() - allocs);
+}
+
+/**
+ * A PlayerV3 gets (and is timed on) the one notifyKill(); a PlayerV2 gets one
+ * timed update() per ship cell, as AIContest would send it.
+ */
+void TimedPlayer::notifyKill( Move ship ) {
+    if( ! playerV3 ) {
+	PlayerV3::notifyKill(ship);
+	return;
+    }
+    long long allocs = allocationCount();
+    long long start = nowNanoseconds();
+    playerV3->notifyKill(ship);
+    long long elapsed = nowNanoseconds() - start;
+    stats[UpdateCall].add(elapsed, allocationCount() - allocs);
+}
+
+Move TimedPlayer::nextPlacement( int length ) {
+    Move move;
+    long long allocs = allocationCount();
+    long long start = nowNanoseconds();
+    if( playerV3 ) {
+	move = playerV3->nextPlacement(length);
+    } else {
+	Message msg = player->placeShip(length);
+	move = toMove(msg);
+    }
+    long long elapsed = nowNanoseconds() - start;
+    stats[PlaceShipCall].add(elapsed, allocationCount() - allocs);
+    return move;
+}
+
+/**
+ * Passes the key on untimed: the wrapped player's moves must not change.
+ */
+void TimedPlayer::seedRandom( uint64_t key ) {
+    if( playerV3 ) playerV3->seedRandom(key);
+}
+
+#endif
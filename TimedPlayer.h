@@ -0,0 +1,82 @@
+/**
+ * TimedPlayer.h: wraps a player and records how long each call takes.
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Every newRound/getMove/update/placeShip call on the wrapped player is timed
+ * in nanoseconds and the heap allocations it makes are counted (allocation
+ * counts need AllocCounter.o linked in). The wrapper is a PlayerV3, so
+ * AIContest talks to it in Moves; a PlayerV2-only player behind it gets
+ * Messages exactly as AIContest would have sent them.
+ */
+
+#ifndef TIMEDPLAYER_H		// Double inclusion protection
+#define TIMEDPLAYER_H
+
+#include <string>
+
+#include "PlayerV3.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+enum PlayerCall { NewRoundCall=0, GetMoveCall, UpdateCall, PlaceShipCall, NumPlayerCalls };
+
+extern const char* playerCallNames[NumPlayerCalls];
+
+/**
+ * Latencies and allocation count for one kind of call. The latencies go into
+ * a LatencyHistogram, so the size stays fixed however many calls are timed.
+ */
+class CallStats {
+    public:
+	CallStats();
+	void add( long long nanoseconds, long long allocations );
+
+	long long count() const;
+	long long allocations() const;
+	double mean() const;
+	/**
+	 * @brief The given percentile (0-100), in nanoseconds, to within the
+	 * histogram's 6%; 100 gives the exact maximum.
+	 */
+	long long percentile( double percent ) const;
+
+	/**
+	 * @brief Writes {"count":..,"mean":..,"p50":..,"p90":..,"p99":..,"max":..,"allocs":..}.
+	 */
+	string toJson() const;
+
+    private:
+	LatencyHistogram latencies;
+	long long totalNanoseconds;
+	long long totalAllocations;
+};
+
+class TimedPlayer : public PlayerV3 {
+    public:
+	/**
+	 * @param player The player to time. TimedPlayer deletes it.
+	 * @param stats NumPlayerCalls entries, indexed by PlayerCall, to add to.
+	 */
+	TimedPlayer( PlayerV2* player, int boardSize, CallStats* stats );
+	~TimedPlayer();
+
+	void newRound();
+	Move nextMove();
+	void notify( Move move );
+	void notifyKill( Move ship );
+	Move nextPlacement( int length );
+	void seedRandom( uint64_t key );
+
+    private:
+	PlayerV2* player;
+	PlayerV3* playerV3;	// player as a PlayerV3, or NULL
+	CallStats* stats;
+
+	// Not copyable.
+	TimedPlayer( const TimedPlayer& );
+	void operator=( const TimedPlayer& );
+};
+
+#endif
@@ -9,11 +9,15 @@
  */
 
 #include <iostream>
-#include <cstdio>
-#include <vector>
 
 #include "USSWhite.h"
 
+//Fleet targeting: sampler time per shot when timed, threads, and a sample
+//cap; and how far an exact count may get before it gives up.
+const int SampleBudgetMicroseconds = 200;
+const int SampleThreads = 1;
+const long SamplesPerShot = 400;
+const int ExactCountStates = 1024;
 
 /**
  * @brief Constructor that initializes any inter-round data structures.
@@ -25,7 +29,8 @@
  * before rounds; newRound() gets called before every round.
  */
 USSWhite::USSWhite( int boardSize )
-    :PlayerV2(boardSize)
+    :PlayerV3(boardSize),
+     targeting(timedTargeting ? SampleBudgetMicroseconds : 0, SampleThreads, SamplesPerShot, ExactCountStates)
 {
     // Could do any initialization of inter-round data structures here.
     this->initializeBoard();
@@ -38,6 +43,9 @@ USSWhite::USSWhite( int boardSize )
     SHIP_PLACEMENT_learning = false;
     doMiddleScan = false;
     doProbabilityScan = true;
+    doFleetTargeting = true;
+    doShotLearning = true;
+    recountEveryMove = false;
 
     if (doMiddleScan) {
         lastRow = int(boardSize/2)-1;
@@ -53,6 +61,16 @@ USSWhite::USSWhite( int boardSize )
 
     resetBoard(enemyShotsIncrementBoard);
     resetBoard(enemyShotsIncrementBoardCopy);
+    // Start the shot history clean; otherwise it begins as whatever was on the heap.
+    resetBoard(myShotsIncrementBoard);
+    tempLastRow = lastRow;
+    tempLastCol = 0;
+    probabilityBonusRow = -1;
+    probabilityBonusCol = -1;
+    clearFleet(enemyFleet);
+    densityFleetChanged = false;
+    missCells = hitCells = sunkCells = killGroup = 0;
+    clearFleet(sunkFleet);
 }
 
 /**
@@ -76,18 +94,30 @@ void USSWhite::initializeBoard() {
 
 /**
  * @brief Specifies the AI's shot choice and returns the information to the caller.
- * @return Message The most important parts of the returned message are 
+ * @return Move The most important parts of the returned move are 
  * the row and column values. 
  *
- * See the Message class documentation for more information on the 
- * Message constructor.
+ * See Move.h for the fields of a Move.
  */
-Message USSWhite::getMove() {
+Move USSWhite::nextMove() {
 
-    initializeProbabilities(probabilityBoard, myShotsBoard);
+    //probabilityBoard is kept current by notify(); only last move's learning bonus is dropped.
+    clearProbabilityBonus();
+    //Recount from scratch once the fleet for this round is known.
+    if (densityFleetChanged || recountEveryMove) {
+        initializeProbabilities(probabilityBoard, myShotsBoard);
+        densityFleetChanged = false;
+    }
     overallShotCount++;
     //addToProbabilitiesBoard();
 
+    //Let the fitting fleets pick the shot; the scan/branch logic below is the fallback.
+    closeKillGroup();
+    Move targetedShot;
+    if (doFleetTargeting && getFleetTargetedMove(targetedShot)) {
+        return targetedShot;
+    }
+
     //If killed enemy ship
     if (board[lastRow][lastCol] == KILL) {
         huntingAnEnemyShip = false;
@@ -142,7 +172,7 @@ Message USSWhite::getMove() {
 }
 
 
-Message USSWhite::RegularScanMove() {
+Move USSWhite::RegularScanMove() {
     if (doProbabilityScan) {
         return getProbabilityScanMove();
     }
@@ -152,7 +182,7 @@ Message USSWhite::RegularScanMove() {
 }
 
 
-Message USSWhite::getCleanPlayerScanMove() {
+Move USSWhite::getCleanPlayerScanMove() {
     lastCol += MIN_SHIP_SIZE;
 
     //Rap around: column. Go to new row
@@ -187,11 +217,24 @@ Message USSWhite::getCleanPlayerScanMove() {
     tempLastRow = lastRow;
     tempLastCol = lastCol;
 
-    Message result( SHOT, lastRow, lastCol, "Bang", None, 1 );
+    Move result = makeMove( SHOT, lastRow, lastCol );
     return result;
 }
 
 
+void USSWhite::setShotModes(bool fleetTargeting, bool shotLearning, bool fullRecount) {
+    doFleetTargeting = fleetTargeting;
+    doShotLearning = shotLearning;
+    recountEveryMove = fullRecount;
+}
+
+bool USSWhite::timedTargeting = false;
+
+void USSWhite::setTimedTargeting(bool timed) {
+    timedTargeting = timed;
+}
+
+
 /**
  * @brief Tells the AI that a new round is beginning.
  * The AI show reinitialize any intra-round data structures.
@@ -217,6 +260,9 @@ void USSWhite::newRound() {
     numShipsPlaced = 0;
     initializeBoard();
     huntingAnEnemyShip = false;
+    clearFleet(enemyFleet);
+    missCells = hitCells = sunkCells = killGroup = 0;
+    clearFleet(sunkFleet);
 
     //Learning ship placement.
     /*
@@ -241,61 +287,76 @@ void USSWhite::newRound() {
 /**
  * @brief Gets the AI's ship placement choice. This is then returned to the caller.
  * @param length The length of the ship to be placed.
- * @return Message The most important parts of the returned message are 
+ * @return Move The most important parts of the returned move are 
  * the direction, row, and column values. 
  *
- * The parameters returned via the message are:
+ * The fields returned via the move are:
  * 1. the operation: must be PLACE_SHIP 
  * 2. ship top row value
  * 3. ship top col value
- * 4. a string for the ship name
- * 5. direction Horizontal/Vertical (see defines.h)
- * 6. ship length (should match the length passed to placeShip)
+ * 4. direction Horizontal/Vertical (see defines.h)
+ * 5. ship length (should match the length passed to placeShip)
  */
-Message USSWhite::placeShip(int length) {
-    char shipName[10];
+Move USSWhite::nextPlacement(int length) {
+    //Both sides are dealt the same ships, so this is also the enemy fleet.
+    if (length >= 1 && length <= MAX_SHIP_SIZE) {
+        enemyFleet.count[length]++;
+        densityFleetChanged = true;
+    }
+
     //Initializing variables, ignore the values
     int topRow = 0;
     int topCol = 0;
     Direction direction = Vertical;
     int directionNum = 0;
-    
-    // Create ship names each time called: Ship0, Ship1, Ship2, ...
-    snprintf(shipName, sizeof shipName, "Ship%d", numShipsPlaced);
+
+    //No room left for this ship (tiny boards): the placement loops below would never end.
+    if (! roomForShip(length)) {
+        return makeMove( PLACE_SHIP, topRow, topCol, direction, length );
+    }
 
     //Prefer lower spots
     if (SHIP_PLACEMENT_low) {
-        return placeShipsLow(topRow, topCol, direction, directionNum, length, shipName);
+        return placeShipsLow(topRow, topCol, direction, directionNum, length);
     }
 
     //Prefer the edges
     else if (SHIP_PLACEMENT_unlikely) {
-        return placeShipsInUnlikelySpots(topRow, topCol, direction, directionNum, length, shipName);
+        return placeShipsInUnlikelySpots(topRow, topCol, direction, directionNum, length);
     }
 
     else if (SHIP_PLACEMENT_learning) {
-        return placeShipsByLearning(topRow, topCol, direction, directionNum, length, shipName);
+        return placeShipsByLearning(topRow, topCol, direction, directionNum, length);
     }
 
     //Random ship placement
     else {
-        return placeShipsRandomly(topRow, topCol, direction, directionNum, length, shipName);
+        return placeShipsRandomly(topRow, topCol, direction, directionNum, length);
     }
 }
 
 /**
  * @brief Updates the AI with the results of its shots and where the opponent is shooting.
- * @param msg Message specifying what happened + row/col as appropriate.
+ * @param msg Move specifying what happened + row/col as appropriate.
  */
-void USSWhite::update(Message msg) {
-    switch(msg.getMessageType()) {
+void USSWhite::notify(Move msg) {
+    switch(msg.type) {
 	case HIT:
 	case KILL:
 	case MISS:
-	    board[msg.getRow()][msg.getCol()] = msg.getMessageType();
-        myShotsBoard[msg.getRow()][msg.getCol()] = msg.getMessageType();
-        //probabilityBoard[msg.getRow()][msg.getCol()] = 0;
-        //updateProbabilities(msg.getRow(), msg.getCol());
+	    board[msg.row][msg.col] = msg.type;
+        recordShotResult(msg.row, msg.col, msg.type);
+        //A kill is reported as one KILL per cell of the ship, back to back.
+        if (msg.type == KILL) {
+            killGroup |= cellBit(msg.row, msg.col);
+        }
+        else {
+            closeKillGroup();
+            if (msg.type == HIT) hitCells |= cellBit(msg.row, msg.col);
+            else missCells |= cellBit(msg.row, msg.col);
+        }
+        //probabilityBoard[msg.row][msg.col] = 0;
+        //updateProbabilities(msg.row, msg.col);
 	    break;
 	case WIN:
         break;
@@ -304,13 +365,29 @@ void USSWhite::update(Message msg) {
 	case TIE:
 	    break;
 	case OPPONENT_SHOT:
-        enemyShotsBoard[msg.getRow()][msg.getCol()] = msg.getMessageType();
+        enemyShotsBoard[msg.row][msg.col] = msg.type;
         //shotWeightMarker--;
 	    break;
     }
 }
 
 
+/**
+ * @brief Tells the AI that its shot sank a ship.
+ * @param ship The ship's top/left row, col, dir and length.
+ */
+void USSWhite::notifyKill(Move ship) {
+    closeKillGroup();
+    for (int i=0; i<ship.length; i++) {
+        Move cell = killCell(ship, i);
+        board[cell.row][cell.col] = KILL;
+        recordShotResult(cell.row, cell.col, KILL);
+        killGroup |= cellBit(cell.row, cell.col);
+    }
+    closeKillGroup();
+}
+
+
 void USSWhite::resetBoard(int Board[][MAX_BOARD_SIZE]) {
     for (int r=0; r<boardSize; r++) {
         for (int c=0; c<boardSize; c++) {
@@ -329,7 +406,7 @@ void USSWhite::resetBoard(char Board[][MAX_BOARD_SIZE]) {
 }
 
 
-Message USSWhite::branchOut() {
+Move USSWhite::branchOut() {
 
     int numSpacesVertical = findNumSpacesVertical(lastRow, lastCol);
     int numSpacesHorizontal = findNumSpacesHorizontal(lastRow, lastCol);
@@ -347,7 +424,7 @@ Message USSWhite::branchOut() {
         for (int row = lastRow-1; row >= 0; row--) {
             if (board[row][lastCol] == WATER) {
                 lastRow = row;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[row][lastCol] == HIT) {
@@ -362,7 +439,7 @@ Message USSWhite::branchOut() {
         for (int row = lastRow+1; row < boardSize; row++) {
             if (board[row][lastCol] == WATER) {
                 lastRow = row;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[row][lastCol] == HIT) {
@@ -381,7 +458,7 @@ Message USSWhite::branchOut() {
             }
             else if (board[lastRow][col] == WATER) {
                 lastCol = col;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[lastRow][col] == HIT) {
@@ -400,7 +477,7 @@ Message USSWhite::branchOut() {
             }
             else if (board[lastRow][col] == WATER) {
                 lastCol = col;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[lastRow][col] == HIT) {
@@ -418,7 +495,7 @@ Message USSWhite::branchOut() {
         for (int col = lastCol+1; col < boardSize; col++) {
             if (board[lastRow][col] == WATER) {
                 lastCol = col;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[lastRow][col] == HIT) {
@@ -433,7 +510,7 @@ Message USSWhite::branchOut() {
         for (int col = lastCol-1; col >= 0; col--) {
             if (board[lastRow][col] == WATER) {
                 lastCol = col;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[lastRow][col] == HIT) {
@@ -452,7 +529,7 @@ Message USSWhite::branchOut() {
             }
             if (board[row][lastCol] == WATER) {
                 lastRow = row;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[row][lastCol] == HIT) {
@@ -471,7 +548,7 @@ Message USSWhite::branchOut() {
             }
             else if (board[row][lastCol] == WATER) {
                 lastRow = row;
-                Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                 return attemptShot;
             }
             else if (board[row][lastCol] == HIT) {
@@ -515,7 +592,7 @@ Message USSWhite::branchOut() {
                     lastRow = row;
                     shotHorizontal = false;
                     shotVertical = true;
-                    Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                    Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                     return attemptShot;
                 }
                 else if (board[row][lastCol] == HIT) {
@@ -534,7 +611,7 @@ Message USSWhite::branchOut() {
                     lastRow = row;
                     shotHorizontal = false;
                     shotVertical = true;
-                    Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                    Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                     return attemptShot;
                 }
                 else if (board[row][lastCol] == HIT) {
@@ -553,7 +630,7 @@ Message USSWhite::branchOut() {
                     lastCol = col;
                     shotVertical = false;
                     shotHorizontal = true;
-                    Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                    Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                     return attemptShot;
                 }
                 else if (board[lastRow][col] == HIT) {
@@ -572,7 +649,7 @@ Message USSWhite::branchOut() {
                     lastCol = col;
                     shotVertical = false;
                     shotHorizontal = true;
-                    Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+                    Move attemptShot = makeMove( SHOT, lastRow, lastCol );
                     return attemptShot;
                 }
                 else if (board[lastRow][col] == HIT) {
@@ -598,7 +675,7 @@ Message USSWhite::branchOut() {
             lastRow = row;
             shotHorizontal = false;
             shotVertical = true;
-            Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+            Move attemptShot = makeMove( SHOT, lastRow, lastCol );
             return attemptShot;
         }
         else if (board[row][lastCol] == HIT) {
@@ -619,7 +696,7 @@ Message USSWhite::branchOut() {
             lastCol = col;
             shotVertical = false;
             shotHorizontal = true;
-            Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+            Move attemptShot = makeMove( SHOT, lastRow, lastCol );
             return attemptShot;
         }
         else if (board[lastRow][col] == HIT) {
@@ -640,7 +717,7 @@ Message USSWhite::branchOut() {
             lastRow = row;
             shotHorizontal = false;
             shotVertical = true;
-            Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+            Move attemptShot = makeMove( SHOT, lastRow, lastCol );
             return attemptShot;
         }
         else if (board[row][lastCol] == HIT) {
@@ -661,7 +738,7 @@ Message USSWhite::branchOut() {
             lastCol = col;
             shotVertical = false;
             shotHorizontal = true;
-            Message attemptShot( SHOT, lastRow, lastCol, "Bang", None, 1);
+            Move attemptShot = makeMove( SHOT, lastRow, lastCol );
             return attemptShot;
         }
         else if (board[lastRow][col] == HIT) {
@@ -701,123 +778,102 @@ bool USSWhite::unpursuedHit() {
 }
 
 
-bool USSWhite::isValidLocation(int Row, int Col, int shipLength, int direction) {
-    //Check if legal (horizontal)
-    if (direction == 0) {
-        if ((Col+shipLength-1) < boardSize) {
-            for (int col=Col; col<(Col+shipLength); col++) {
-                if (myShipBoard[Row][col] == SHIP) {
-                    return true;
-                }
+//Returns true if some placement of a ship of this length is still free.
+bool USSWhite::roomForShip(int shipLength) {
+    CellMask blocked = myShipCells | outsideBoard(boardSize);
+    for (int r=0; r<boardSize; r++) {
+        for (int c=0; c<boardSize; c++) {
+            if ((placementMask(shipLength, true, r, c) & blocked) == 0 || (placementMask(shipLength, false, r, c) & blocked) == 0) {
+                return true;
             }
         }
-        else {
-            return true;
-        }
     }
+    return false;
+}
 
-    //Check if legal (vertical)
-    else {
-        if ((Row+shipLength-1) < boardSize) {
-            for (int row=Row; row<(Row+shipLength); row++) {
-                if (myShipBoard[row][Col] == SHIP) {
-                    return true;
-                }
-            }
-        }
-        else {
-            return true;
-        }
-    }
 
-    return false;
+//Returns true if the ship would leave the board or overlap one of ours (i.e., true = invalid).
+bool USSWhite::isValidLocation(int Row, int Col, int shipLength, int direction) {
+    CellMask ship = placementMask(shipLength, direction == 0, Row, Col);
+    return (ship & (myShipCells | outsideBoard(boardSize))) != 0;
 }
 
 
-Message USSWhite::placeShipsRandomly(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]) {
+Move USSWhite::placeShipsRandomly(int Row, int Col, Direction direction, int directionNum, int shipLength) {
     bool invalid = true;  //get the loop started
     while (invalid) {
         invalid = false;
-        directionNum = rand() % 2;
+        directionNum = gameRandom.below(2);
         if (directionNum == 0) {
             direction = Horizontal;
-            Row = rand() % boardSize;
-            Col = rand() % (boardSize - shipLength + 1);
+            Row = gameRandom.below(boardSize);
+            Col = gameRandom.below(boardSize - shipLength + 1);
         }
         else {
             direction = Vertical;
-            Row = rand() % (boardSize - shipLength + 1);
-            Col = rand() % boardSize;
+            Row = gameRandom.below(boardSize - shipLength + 1);
+            Col = gameRandom.below(boardSize);
         }
         invalid = isValidLocation(Row, Col, shipLength, directionNum);
     }
 
-    // parameters = mesg type (PLACE_SHIP), row, col, a string, direction (Horizontal/Vertical)
-    Message response( PLACE_SHIP, Row, Col, shipName, direction, shipLength );
+    // parameters = mesg type (PLACE_SHIP), row, col, direction (Horizontal/Vertical), length
+    Move response = makeMove( PLACE_SHIP, Row, Col, direction, shipLength );
     numShipsPlaced++;
 
-    //Update myShipBoard to keep track
-    if (directionNum == 0) {
-        for (int col=Col; col<(Col+shipLength); col++) {
-            myShipBoard[Row][col] = SHIP;
-        }
-    }
-    else {
-        for (int row=Row; row<(Row+shipLength); row++) {
-            myShipBoard[row][Col] = SHIP;
-        }
-    }
+    //Update myShipCells to keep track
+    myShipCells |= placementMask(shipLength, directionNum == 0, Row, Col);
 
     return response;
 }
 
 
 
-Message USSWhite::placeShipsLow(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]) {
+Move USSWhite::placeShipsLow(int Row, int Col, Direction direction, int directionNum, int shipLength) {
     bool invalid = true;  //get the loop started
     int counter = 0;
     while (invalid) {
         invalid = false;
 
         if (counter >= 50) {
-            Row = rand() % boardSize;
-            Col = rand() % boardSize;
-            directionNum = rand() % 2;
+            Row = gameRandom.below(boardSize);
+            Col = gameRandom.below(boardSize);
+            directionNum = gameRandom.below(2);
         }
 
         else if (numShipsPlaced == 0) {  //Have at least one ship way at the bottom
             Row = boardSize-1;
-            Col = rand() % boardSize;
+            Col = gameRandom.below(boardSize);
             directionNum = 0;
         }
 
         else if (numShipsPlaced < 3) {  //Prefer lower spots for first 3 ships
-            Row = int(boardSize/2) + rand() % int(boardSize/2);
-            Col = rand() % boardSize;
-            directionNum = rand() % 2;
+            Row = int(boardSize/2) + gameRandom.below(int(boardSize/2));
+            Col = gameRandom.below(boardSize);
+            directionNum = gameRandom.below(2);
             if (directionNum == 0) {
                 direction = Horizontal;
-                Row = int(boardSize/2) + rand() % int(boardSize/2);
-                Col = rand() % (boardSize - shipLength + 1);
+                Row = int(boardSize/2) + gameRandom.below(int(boardSize/2));
+                Col = gameRandom.below(boardSize - shipLength + 1);
             }
             else {
                 direction = Vertical;
-                Row = int(boardSize/2) + rand() % int(boardSize/2);
-                Col = rand() % boardSize;
+                Row = int(boardSize/2) + gameRandom.below(int(boardSize/2));
+                Col = gameRandom.below(boardSize);
             }
         }
 
         else {  //Otherwise just random
-            directionNum = rand() % 2;
+            directionNum = gameRandom.below(2);
             if (directionNum == 0) {
                 direction = Horizontal;
-                Row = rand() % boardSize;
-                Col = rand() % (boardSize - shipLength + 1);
+                Row = gameRandom.below(boardSize);
+                Col = gameRandom.below(boardSize - shipLength + 1);
             }
             else {
                 direction = Vertical;
-                Row = rand() % (boardSize - shipLength + 1);
-                Col = rand() % boardSize;
+                Row = gameRandom.below(boardSize - shipLength + 1);
+                Col = gameRandom.below(boardSize);
             }
         }
 
@@ -833,21 +889,12 @@ Message USSWhite::placeShipsLow(int Row, int Col, Direction direction, int direc
         direction = Vertical;
     }
 
-    // parameters = mesg type (PLACE_SHIP), row, col, a string, direction (Horizontal/Vertical)
-    Message response( PLACE_SHIP, Row, Col, shipName, direction, shipLength );
+    // parameters = mesg type (PLACE_SHIP), row, col, direction (Horizontal/Vertical), length
+    Move response = makeMove( PLACE_SHIP, Row, Col, direction, shipLength );
     numShipsPlaced++;
 
-    //Update myShipBoard to keep track
-    if (directionNum == 0) {
-        for (int col=Col; col<(Col+shipLength); col++) {
-            myShipBoard[Row][col] = SHIP;
-        }
-    }
-    else {
-        for (int row=Row; row<(Row+shipLength); row++) {
-            myShipBoard[row][Col] = SHIP;
-        }
-    }
+    //Update myShipCells to keep track
+    myShipCells |= placementMask(shipLength, directionNum == 0, Row, Col);
 
     return response;
 }
@@ -872,54 +919,158 @@ void USSWhite::initializeProbabilities(int Board[][MAX_BOARD_SIZE], char shotsBo
     resetBoard(probabilityBoard);
     calculateHorizontal(Board,shotsBoard);
     calculateVertical(Board,shotsBoard);
+    probabilityBonusRow = -1;
+    probabilityBonusCol = -1;
+}
+
+
+/*
+ * A cell can still hold part of an unsunk ship if it is water or an unsunk hit.
+ */
+static bool isOpenCell(char shot) {
+    return shot == WATER || shot == HIT;
+}
+
+
+/*
+ * The fleet used for the density: the ships we were asked to place this round,
+ * since both sides get the same fleet. Falls back to one smallest ship (the
+ * old length-3 window count) until placements have been seen.
+ */
+const FleetCounts& USSWhite::densityFleet() {
+    static FleetCounts smallestShip = {{0, 0, 0, 1}};
+    return fleetSize(enemyFleet) > 0 ? enemyFleet : smallestShip;
+}
+
+
+/*
+ * Records a shot result in myShotsBoard and keeps probabilityBoard equal to what
+ * initializeProbabilities() would compute from it. A cell only ever goes from open
+ * (WATER/HIT) to closed (MISS/KILL), and then only the placements through it
+ * change, so just the cells of its row and column within a ship length of it are
+ * updated.
+ */
+void USSWhite::recordShotResult(int Row, int Col, char result) {
+    bool closing = isOpenCell(myShotsBoard[Row][Col]) && ! isOpenCell(result);
+    myShotsBoard[Row][Col] = result;
+    if (closing) {
+        closeRowCell(Row, Col);
+        closeColCell(Row, Col);
+    }
+}
+
+
+/*
+ * Takes the horizontal placements through (Row, Col) out of row Row's counts and
+ * probabilityBoard, and closes the cell in openRows.
+ */
+void USSWhite::closeRowCell(int Row, int Col) {
+    int first = Col-MAX_SHIP_SIZE+1 < 0 ? 0 : Col-MAX_SHIP_SIZE+1;
+    int last = Col+MAX_SHIP_SIZE-1 < boardSize ? Col+MAX_SHIP_SIZE-1 : boardSize-1;
+    int density[MAX_BOARD_SIZE];
+    for (int c=first; c<=last; c++) {
+        density[c] = horizontalDensity[Row][c];
+    }
+    closeLineCell(openRows[Row], Col, densityFleet(), density);
+    for (int c=first; c<=last; c++) {
+        probabilityBoard[Row][c] += density[c] - horizontalDensity[Row][c];
+        horizontalDensity[Row][c] = density[c];
+    }
+    openRows[Row] &= ~(LineMask(1) << Col);
+}
+
+
+/*
+ * Takes the vertical placements through (Row, Col) out of column Col's counts and
+ * probabilityBoard, and closes the cell in openCols.
+ */
+void USSWhite::closeColCell(int Row, int Col) {
+    int first = Row-MAX_SHIP_SIZE+1 < 0 ? 0 : Row-MAX_SHIP_SIZE+1;
+    int last = Row+MAX_SHIP_SIZE-1 < boardSize ? Row+MAX_SHIP_SIZE-1 : boardSize-1;
+    int density[MAX_BOARD_SIZE];
+    for (int r=first; r<=last; r++) {
+        density[r] = verticalDensity[r][Col];
+    }
+    closeLineCell(openCols[Col], Row, densityFleet(), density);
+    for (int r=first; r<=last; r++) {
+        probabilityBoard[r][Col] += density[r] - verticalDensity[r][Col];
+        verticalDensity[r][Col] = density[r];
+    }
+    openCols[Col] &= ~(LineMask(1) << Row);
 }
 
 
+/*
+ * Takes back the +10 dealWithLearningShotPlacement() gave one cell for the last move.
+ */
+void USSWhite::clearProbabilityBonus() {
+    if (probabilityBonusRow >= 0) {
+        probabilityBoard[probabilityBonusRow][probabilityBonusCol] -= 10;
+        probabilityBonusRow = -1;
+        probabilityBonusCol = -1;
+    }
+}
+
+
+/*
+ * Adds the number of horizontal placements of each fleet ship through every cell to Board.
+ */
 void USSWhite::calculateHorizontal(int Board[][MAX_BOARD_SIZE], char shotsBoard[][MAX_BOARD_SIZE]) {
     for (int r=0; r<boardSize; r++) {
-        for (int c=0; c<boardSize-MIN_SHIP_SIZE+1; c++) {
-            if ((shotsBoard[r][c] == WATER || shotsBoard[r][c] == HIT) && (shotsBoard[r][c+1] == WATER || shotsBoard[r][c+1] == HIT) && (shotsBoard[r][c+2] == WATER || shotsBoard[r][c+2] == HIT)) {
-                Board[r][c] += 1;
-                Board[r][c+1] += 1;
-                Board[r][c+2] += 1;
+        openRows[r] = 0;
+        for (int c=0; c<boardSize; c++) {
+            if (isOpenCell(shotsBoard[r][c])) {
+                openRows[r] |= LineMask(1) << c;
             }
         }
+        lineDensity(openRows[r], boardSize, densityFleet(), horizontalDensity[r]);
+        for (int c=0; c<boardSize; c++) {
+            Board[r][c] += horizontalDensity[r][c];
+        }
     }
 }
 
 
 
+/*
+ * Adds the number of vertical placements of each fleet ship through every cell to Board.
+ */
 void USSWhite::calculateVertical(int Board[][MAX_BOARD_SIZE], char shotsBoard[][MAX_BOARD_SIZE]) {
     for (int c=0; c<boardSize; c++) {
-        for (int r=0; r<boardSize-MIN_SHIP_SIZE+1; r++) {
-            if ((shotsBoard[r][c] == WATER || shotsBoard[r][c] == HIT) && (shotsBoard[r+1][c] == WATER || shotsBoard[r+1][c] == HIT) && (shotsBoard[r+2][c] == WATER || shotsBoard[r+2][c] == HIT)) {
-                Board[r][c] += 1;
-                Board[r+1][c] += 1;
-                Board[r+2][c] += 1;
+        openCols[c] = 0;
+        for (int r=0; r<boardSize; r++) {
+            if (isOpenCell(shotsBoard[r][c])) {
+                openCols[c] |= LineMask(1) << r;
             }
         }
+        int density[MAX_BOARD_SIZE];
+        lineDensity(openCols[c], boardSize, densityFleet(), density);
+        for (int r=0; r<boardSize; r++) {
+            verticalDensity[r][c] = density[r];
+            Board[r][c] += density[r];
+        }
     }
 }
 
 
-Message USSWhite::fireBestShot(int probabilityBoard[][MAX_BOARD_SIZE]) {
+Move USSWhite::fireBestShot(int probabilityBoard[][MAX_BOARD_SIZE]) {
     int highestProbability = findHighestProbability(probabilityBoard);
-    std::vector<int> placesToTry_Rows;
-    std::vector<int> placesToTry_Cols;
+    int placesToTry_Rows[MAX_BOARD_SIZE*MAX_BOARD_SIZE];
+    int placesToTry_Cols[MAX_BOARD_SIZE*MAX_BOARD_SIZE];
     int numPlacesToTry = 0;
     for (int r=0; r<boardSize; r++) {
         for (int c=0; c<boardSize; c++) {
-            if (probabilityBoard[r][c] == highestProbability) {
+            if (probabilityBoard[r][c] == highestProbability && myShotsBoard[r][c] == WATER) {
+                placesToTry_Rows[numPlacesToTry] = r;
+                placesToTry_Cols[numPlacesToTry] = c;
                 numPlacesToTry += 1;
-                placesToTry_Rows.push_back(r);
-                placesToTry_Cols.push_back(c);
             }
         }
     }
-    int index = rand() % numPlacesToTry;
+    int index = gameRandom.below(numPlacesToTry);
     int row = placesToTry_Rows[index];
     int col = placesToTry_Cols[index];
-    Message result( SHOT, row, col, "Bang", None, 1 );
+    Move result = makeMove( SHOT, row, col );
     return result;
 }
 
@@ -937,48 +1088,51 @@ int USSWhite::findHighestProbability(int probabilityBoard[][MAX_BOARD_SIZE]) {
 }
 
 
-Message USSWhite::getProbabilityScanMove() {
-    dealWithLearningShotPlacement();
+Move USSWhite::getProbabilityScanMove() {
+    if (doShotLearning) {
+        dealWithLearningShotPlacement();
+    }
     probabilityScanShotCount++;
     return fireBestShot(probabilityBoard);
 }
 
 
 void USSWhite::resetBoards() {
-    resetBoard(myShipBoard);
+    myShipCells = 0;
     resetBoard(myShotsBoard);
     resetBoard(enemyShotsBoard);
     resetBoard(probabilityBoard);
 }
 
 
-Message USSWhite::placeShipsInUnlikelySpots(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]) {
+Move USSWhite::placeShipsInUnlikelySpots(int Row, int Col, Direction direction, int directionNum, int shipLength) {
     bool invalid = true;  
+    bool useFixedSpot = true;  //if the fixed spot is taken (small boards), go random
     while (invalid) {
         invalid = false;
 
-        if (numShipsPlaced == 0) {
+        if (useFixedSpot && numShipsPlaced == 0) {
             direction = Horizontal;
             directionNum = 0;
             Row = boardSize-1;
             Col = boardSize-shipLength;
         }
         
-        else if (numShipsPlaced == 1) {
+        else if (useFixedSpot && numShipsPlaced == 1) {
             direction = Horizontal;
             directionNum = 0;
             Row = 0;
             Col = 0;
         }
 
-        else if (numShipsPlaced == 2) {
+        else if (useFixedSpot && numShipsPlaced == 2) {
             direction = Vertical;
             directionNum = 1;
             Row = 0;
             Col = boardSize-1;
         }
 
-        else if (numShipsPlaced == 3) {
+        else if (useFixedSpot && numShipsPlaced == 3) {
             direction = Horizontal;
             directionNum = 0;
             Row = boardSize-1;
@@ -987,36 +1141,28 @@ Message USSWhite::placeShipsInUnlikelySpots(int Row, int Col, Direction directio
 
         else {
             //Random placement
-            directionNum = rand() % 2;
+            directionNum = gameRandom.below(2);
             if (directionNum == 0) {
                 direction = Horizontal;
-                Row = rand() % boardSize;
-                Col = rand() % (boardSize - shipLength + 1);
+                Row = gameRandom.below(boardSize);
+                Col = gameRandom.below(boardSize - shipLength + 1);
             }
             else {
                 direction = Vertical;
-                Row = rand() % (boardSize - shipLength + 1);
-                Col = rand() % boardSize;
+                Row = gameRandom.below(boardSize - shipLength + 1);
+                Col = gameRandom.below(boardSize);
             }
         }
         invalid = isValidLocation(Row, Col, shipLength, directionNum);
+        useFixedSpot = false;
     }
 
 
-    Message response( PLACE_SHIP, Row, Col, shipName, direction, shipLength );
+    Move response = makeMove( PLACE_SHIP, Row, Col, direction, shipLength );
     numShipsPlaced++;
 
-    //Update myShipBoard to keep track
-    if (directionNum == 0) {
-        for (int col=Col; col<(Col+shipLength); col++) {
-            myShipBoard[Row][col] = SHIP;
-        }
-    }
-    else {
-        for (int row=Row; row<(Row+shipLength); row++) {
-            myShipBoard[row][Col] = SHIP;
-        }
-    }
+    //Update myShipCells to keep track
+    myShipCells |= placementMask(shipLength, directionNum == 0, Row, Col);
 
     return response;
 }
@@ -1043,143 +1189,95 @@ void USSWhite::updateEnemyShotsIncrementBoard() {
 }
 
 
-Message USSWhite::placeShipsByLearning(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]) {
+Move USSWhite::placeShipsByLearning(int Row, int Col, Direction direction, int directionNum, int shipLength) {
 
     setDirectionBasedOnProbability(direction, directionNum, shipLength);
 
     //Updates row and col
     findBestPlaceForShip(Row, Col, shipLength, directionNum, direction);
 
-    Message response(PLACE_SHIP, Row, Col, shipName, direction, shipLength);
+    Move response = makeMove( PLACE_SHIP, Row, Col, direction, shipLength );
     numShipsPlaced++;
 
-    //Update myShipBoard to keep track
-    if (directionNum == 0) {
-        for (int col=Col; col<(Col+shipLength); col++) {
-            myShipBoard[Row][col] = SHIP;
-        }
-    }
-    else {
-        for (int row=Row; row<(Row+shipLength); row++) {
-            myShipBoard[row][Col] = SHIP;
-        }
-    }
+    //Update myShipCells to keep track
+    myShipCells |= placementMask(shipLength, directionNum == 0, Row, Col);
 
     return response;
 }
 
 
+/*
+ * Sum of Board over the cells of a ship.
+ */
+int USSWhite::placementWeight(int Board[][MAX_BOARD_SIZE], CellMask ship) {
+    int weight = 0;
+    for (; ship != 0; ship &= ship - 1) {
+        int cell = firstCell(ship);
+        weight += Board[cell / CellMaskStride][cell % CellMaskStride];
+    }
+    return weight;
+}
+
+
 void USSWhite::findBestPlaceForShip(int& bestRow, int& bestCol, int shipLength, int directionNum, Direction direction) {
-    int counter = 0;
+    bool horiz = directionNum == 0;
+    CellMask outside = outsideBoard(boardSize);
     int lowestCount = 9999999;
 
-    //Horizontal
-    if (directionNum == 0) {
-
-        //Find lowest count.
-        for (int r=0; r<boardSize; r++) {
-            for (int c=0; c<boardSize-shipLength+1; c++) {
-                for (int i=0; i<shipLength; i++) {
-                    counter+=enemyShotsIncrementBoardCopy[r][c+i];
-                }
+    //Find lowest count.
+    for (int r=0; r<boardSize; r++) {
+        for (int c=0; c<boardSize; c++) {
+            CellMask ship = placementMask(shipLength, horiz, r, c);
+            if ((ship & outside) == 0) {
+                int counter = placementWeight(enemyShotsIncrementBoardCopy, ship);
                 if (counter < lowestCount) {
                     lowestCount = counter;
                 }
-                counter = 0;
-            }
-        }
-
-        //Now find lowest count, use that row and col.
-        for (int r=0; r<boardSize; r++) {
-            for (int c=0; c<boardSize-shipLength+1; c++) {
-                for (int i=0; i<shipLength; i++) {
-                    counter+=enemyShotsIncrementBoardCopy[r][c+i];
-                }
-                if (counter == lowestCount) {
-                    bestRow = r;
-                    bestCol = c;
-                    //Update that spot so another ship won't be placed there.
-                    for (int i=0; i<shipLength; i++) {
-                        enemyShotsIncrementBoardCopy[bestRow][bestCol+i]+=9999999;
-                    }
-                    return;
-                }
-                counter = 0;
             }
         }
     }
 
-    //Vertical
-    else {
-        //Find lowest count.
-        for (int r=0; r<boardSize-shipLength+1; r++) {
-            for (int c=0; c<boardSize; c++) {
-                for (int i=0; i<shipLength; i++) {
-                    counter+=enemyShotsIncrementBoardCopy[r+i][c];
-                }
-                if (counter < lowestCount) {
-                    lowestCount = counter;
-                }
-                counter = 0;
-            }
-        }
-
-        //Now find lowest count, use that row and col.
-        for (int r=0; r<boardSize-shipLength+1; r++) {
-            for (int c=0; c<boardSize; c++) {
-                for (int i=0; i<shipLength; i++) {
-                    counter+=enemyShotsIncrementBoardCopy[r+i][c];
-                }
-                if (counter == lowestCount) {
-                    bestRow = r;
-                    bestCol = c;
-                    //Update that spot so another ship won't be placed there.
-                    for (int i=0; i<shipLength; i++) {
-                        enemyShotsIncrementBoardCopy[bestRow+i][bestCol]+=9999999;
-                    }
-                    return;
+    //Now find lowest count, use that row and col.
+    for (int r=0; r<boardSize; r++) {
+        for (int c=0; c<boardSize; c++) {
+            CellMask ship = placementMask(shipLength, horiz, r, c);
+            if ((ship & outside) == 0 && placementWeight(enemyShotsIncrementBoardCopy, ship) == lowestCount) {
+                bestRow = r;
+                bestCol = c;
+                //Update that spot so another ship won't be placed there.
+                for (; ship != 0; ship &= ship - 1) {
+                    int cell = firstCell(ship);
+                    enemyShotsIncrementBoardCopy[cell / CellMaskStride][cell % CellMaskStride] += 9999999;
                 }
-                counter = 0;
+                return;
             }
         }
     }
-       
 }
 
 
 void USSWhite::setDirectionBasedOnProbability(Direction& direction,int& directionNum, int shipLength) {
-    int counter = 0;
+    CellMask outside = outsideBoard(boardSize);
     int lowestCountHorizontal = 9999999;
     int lowestCountVertical = 9999999;
 
-    //Horizontal.
-    //Find lowest count.
+    //Find lowest count in each direction.
     for (int r=0; r<boardSize; r++) {
-        for (int c=0; c<boardSize-shipLength+1; c++) {
-            for (int i=0; i<shipLength; i++) {
-                counter+=enemyShotsIncrementBoard[r][c+i];
-            }
-            if (counter < lowestCountHorizontal) {
-                lowestCountHorizontal = counter;
-            }
-            counter = 0;
-        }
-    }
-
-    //To be safe.
-    counter = 0;
-
-    //Vertical.
-    //Find lowest count.
-    for (int r=0; r<boardSize-shipLength+1; r++) {
         for (int c=0; c<boardSize; c++) {
-            for (int i=0; i<shipLength; i++) {
-                counter+=enemyShotsIncrementBoard[r+i][c];
+            CellMask horizontal = placementMask(shipLength, true, r, c);
+            if ((horizontal & outside) == 0) {
+                int counter = placementWeight(enemyShotsIncrementBoard, horizontal);
+                if (counter < lowestCountHorizontal) {
+                    lowestCountHorizontal = counter;
+                }
             }
-            if (counter < lowestCountVertical) {
-                lowestCountVertical = counter;
+            CellMask vertical = placementMask(shipLength, false, r, c);
+            if ((vertical & outside) == 0) {
+                int counter = placementWeight(enemyShotsIncrementBoard, vertical);
+                if (counter < lowestCountVertical) {
+                    lowestCountVertical = counter;
+                }
             }
-            counter = 0;
         }
     }
 
@@ -1195,7 +1293,7 @@ void USSWhite::setDirectionBasedOnProbability(Direction& direction,int& directio
     }
     //Both the same odds.
     else {
-        directionNum = rand() % 2;
+        directionNum = gameRandom.below(2);
         if (directionNum == 0) {
             direction = Horizontal;
         }
@@ -1326,8 +1424,8 @@ void USSWhite::dealWithLearningShotPlacement() {
         int col;
         int counter = 0;
         int numPlacesToTry = 0;
-        std::vector<int> rows;
-        std::vector<int> cols;
+        int rows[MAX_BOARD_SIZE*MAX_BOARD_SIZE];
+        int cols[MAX_BOARD_SIZE*MAX_BOARD_SIZE];
         int mostProbablePlaceForAnEnemyShipBasedOnGameHistory = findHighestProbability(myShotsIncrementBoard);
 
         while (counter < 10) {
@@ -1336,14 +1434,14 @@ void USSWhite::dealWithLearningShotPlacement() {
             for (int r=0; r<boardSize; r++) {
                 for (int c=0; c<boardSize; c++) {
                     if (myShotsIncrementBoard[r][c] == mostProbablePlaceForAnEnemyShipBasedOnGameHistory) {
+                        rows[numPlacesToTry] = r;
+                        cols[numPlacesToTry] = c;
                         numPlacesToTry += 1;
-                        rows.push_back(r);
-                        cols.push_back(c);
                     }
                 }
             }
             
-            index = rand() % numPlacesToTry;
+            index = gameRandom.below(numPlacesToTry);
             row = rows[index];
             col = cols[index];
             //Check if move would be inefficient.
@@ -1353,11 +1451,11 @@ void USSWhite::dealWithLearningShotPlacement() {
             }
             else {
                 probabilityBoard[row][col] += 10;
+                probabilityBonusRow = row;
+                probabilityBonusCol = col;
                 break;
             }
             numPlacesToTry = 0;
-            rows.clear();
-            cols.clear();
         }
     }
 }
@@ -1411,3 +1509,73 @@ int USSWhite::findNumSpacesHorizontal(int Row, int Col) {
 
     return numSpacesRight + numSpacesLeft;
 }
+
+
+/*
+ * Files the KILL cells reported so far as one sunk ship.
+ */
+void USSWhite::closeKillGroup() {
+    if (killGroup == 0) {
+        return;
+    }
+    int length = cellCount(killGroup);
+    if (length <= MAX_SHIP_SIZE) {
+        sunkFleet.count[length]++;
+    }
+    sunkCells |= killGroup;
+    hitCells &= ~killGroup;
+    killGroup = 0;
+}
+
+
+/*
+ * Weighs the unshot cells by how many of the fleets that fit every shot so far
+ * put a ship there (counted exactly or sampled, see TargetingEngine.h) and
+ * shoots the heaviest one (ties broken at random).
+ * Returns false if the fleet is unknown or no fleet fits.
+ */
+bool USSWhite::getFleetTargetedMove(Move& move) {
+    ShotEvidence evidence;
+    evidence.boardSize = boardSize;
+    evidence.misses = missCells;
+    evidence.hits = hitCells;
+    evidence.sunk = sunkCells;
+    evidence.numShips = 0;
+    for (int length=1; length<=MAX_SHIP_SIZE; length++) {
+        for (int i=sunkFleet.count[length]; i<enemyFleet.count[length] && evidence.numShips<MaxFleetShips; i++) {
+            evidence.shipLengths[evidence.numShips++] = length;
+        }
+    }
+    if (evidence.numShips == 0) {
+        return false;
+    }
+
+    uint64_t seed = gameRandom.next();
+    double cellWeights[CellCountSize];
+    if (! targeting.cellWeights(evidence, seed, cellWeights)) {
+        return false;
+    }
+
+    double best = 0;
+    int numBest = 0;
+    int bestCells[MAX_BOARD_SIZE*MAX_BOARD_SIZE];
+    for (int r=0; r<boardSize; r++) {
+        for (int c=0; c<boardSize; c++) {
+            double weight = cellWeights[r*CellMaskStride + c];
+            if (board[r][c] != WATER || weight < best || weight == 0) continue;
+            if (weight > best) {
+                best = weight;
+                numBest = 0;
+            }
+            bestCells[numBest++] = r*CellMaskStride + c;
+        }
+    }
+    if (numBest == 0) {
+        return false;
+    }
+    int cell = bestCells[gameRandom.below(numBest)];
+    lastRow = tempLastRow = cell / CellMaskStride;
+    lastCol = tempLastCol = cell % CellMaskStride;
+    move = makeMove( SHOT, lastRow, lastCol );
+    return true;
+}
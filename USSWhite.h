@@ -11,20 +11,38 @@
 
 using namespace std;
 
-#include "PlayerV2.h"
-#include "Message.h"
+#include "PlayerV3.h"
+#include "Move.h"
 #include "defines.h"
+#include "PlacementDensity.h"
+#include "PlacementTable.h"
+#include "TargetingEngine.h"
 
-// USSWhite inherits from/extends PlayerV2
+// USSWhite inherits from/extends PlayerV3
 
-class USSWhite: public PlayerV2 {
+class USSWhite: public PlayerV3 {
     public:
 	USSWhite( int boardSize );
 	~USSWhite();
 	void newRound();
-	Message placeShip(int length);
-	Message getMove();
-	void update(Message msg);
+	Move nextPlacement(int length);
+	Move nextMove();
+	void notify(Move move);
+	void notifyKill(Move ship);
+	/**
+	 * @brief Turns shot modes on or off: the fleet targeting and the learned
+	 * scan bonus (both on by default), and recounting probabilityBoard from
+	 * scratch before every shot instead of keeping it current (off). For
+	 * densitytest, which checks the kept board against the recount.
+	 */
+	void setShotModes(bool fleetTargeting, bool shotLearning, bool fullRecount);
+	/**
+	 * @brief Whether USSWhites made from now on give their fleet targeting
+	 * a fixed time per shot (see TargetingEngine.h). Off by default: the
+	 * targeting then never reads the clock, so a seeded game plays the same
+	 * at any speed. Set before any players are made.
+	 */
+	static void setTimedTargeting(bool timed);
 
     private:
     //Initial stuff
@@ -38,7 +56,7 @@ class USSWhite: public PlayerV2 {
     //Boards
     int numShipsPlaced;
     char board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
-    char myShipBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    CellMask myShipCells;  //cells of the ships we have placed this round
     char myShotsBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
 
     //Cleanup stuff
@@ -47,8 +65,8 @@ class USSWhite: public PlayerV2 {
     void resetBoards();
     
     //Scanning move stuff
-    Message RegularScanMove();
-    Message getCleanPlayerScanMove();
+    Move RegularScanMove();
+    Move getCleanPlayerScanMove();
     bool doMiddleScan;  //start cleanPlayer scan from middle
     void adjustShotToBeNew();
     
@@ -58,7 +76,7 @@ class USSWhite: public PlayerV2 {
     bool shotHorizontal;
     bool enemyShipIsVertical;
     bool enemyShipIsHorizontal;
-    Message branchOut();
+    Move branchOut();
     int findNumSpacesVertical(int Row, int Col);
     int findNumSpacesHorizontal(int Row, int Col);
     void resetShotBools();
@@ -66,23 +84,50 @@ class USSWhite: public PlayerV2 {
 
     //Ship placement stuff
     bool isValidLocation(int Row, int Col, int shipLength, int direction);
-    Message placeShipsRandomly(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]);
-    Message placeShipsLow(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]);
+    bool roomForShip(int shipLength);
+    Move placeShipsRandomly(int Row, int Col, Direction direction, int directionNum, int shipLength);
+    Move placeShipsLow(int Row, int Col, Direction direction, int directionNum, int shipLength);
     bool SHIP_PLACEMENT_low;  //true = place ships low
     bool SHIP_PLACEMENT_unlikely;  //true = place ships on edges
-    Message placeShipsInUnlikelySpots(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]);
+    Move placeShipsInUnlikelySpots(int Row, int Col, Direction direction, int directionNum, int shipLength);
     
     //Probability stuff
     bool doProbabilityScan;  //true = do gambler-like scanning
     int probabilityBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
     void initializeProbabilities(int Board[][MAX_BOARD_SIZE], char shotsBoard[][MAX_BOARD_SIZE]);
+    void recordShotResult(int Row, int Col, char result);
+    void closeRowCell(int Row, int Col);
+    void closeColCell(int Row, int Col);
+    void clearProbabilityBonus();
+    const FleetCounts& densityFleet();
+    FleetCounts enemyFleet;  //ships we were asked to place this round
+    bool densityFleetChanged;  //true = recount probabilityBoard before the next shot
+    LineMask openRows[MAX_BOARD_SIZE];  //bit c = myShotsBoard[r][c] is WATER or HIT
+    LineMask openCols[MAX_BOARD_SIZE];  //bit r = myShotsBoard[r][c] is WATER or HIT
+    int horizontalDensity[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    int verticalDensity[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    int probabilityBonusRow;  //cell given the learning bonus this move, -1 if none
+    int probabilityBonusCol;
+    bool recountEveryMove;  //true = initializeProbabilities() before every shot (the old way)
 	void calculateHorizontal(int Board[][MAX_BOARD_SIZE],char shotsBoard[][MAX_BOARD_SIZE]);
 	void calculateVertical(int Board[][MAX_BOARD_SIZE],char shotsBoard[][MAX_BOARD_SIZE]);
 	int findHighestProbability(int probabilityBoard[][MAX_BOARD_SIZE]);
-	Message fireBestShot(int probabilityBoard[][MAX_BOARD_SIZE]);
-    Message getProbabilityScanMove();
+	Move fireBestShot(int probabilityBoard[][MAX_BOARD_SIZE]);
+    Move getProbabilityScanMove();
     int randNum;
 
+    //Fleet targeting stuff
+    bool doFleetTargeting;  //true = shoot where fitting enemy fleets most often put a ship
+    TargetingEngine targeting;
+    static bool timedTargeting;  //see setTimedTargeting()
+    CellMask missCells;  //our misses this round
+    CellMask hitCells;  //our hits on ships not yet known to be sunk
+    CellMask sunkCells;  //cells of the enemy ships we have sunk
+    CellMask killGroup;  //KILL cells of the ship being reported right now
+    FleetCounts sunkFleet;  //lengths of the enemy ships we have sunk
+    void closeKillGroup();
+    bool getFleetTargetedMove(Move& move);
+
     //Learning-based ship placement stuff
     char enemyShotsBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
     int enemyShotsIncrementBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
@@ -90,13 +135,15 @@ class USSWhite: public PlayerV2 {
     void copyBoard(int destinationBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE],int sourceBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE]);
     void updateEnemyShotsIncrementBoard();
     bool SHIP_PLACEMENT_learning;
-    Message placeShipsByLearning(int Row, int Col, Direction direction, int directionNum, int shipLength, char shipName[]);
+    Move placeShipsByLearning(int Row, int Col, Direction direction, int directionNum, int shipLength);
 	void findBestPlaceForShip(int& bestRow, int& bestCol, int shipLength, int directionNum, Direction direction);
+    int placementWeight(int Board[][MAX_BOARD_SIZE], CellMask ship);
     void setDirectionBasedOnProbability(Direction& direction, int& directionNum, int shipLength);
     
     //Learning-based shot placement stuff
     int probabilityScanShotCount;
     int overallShotCount;
+    bool doShotLearning;  //true = bonus to the cell past games hit most
     void dealWithLearningShotPlacement();
     void updateProbabilities(int lastRow, int lastCol);
     int myShotsIncrementBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
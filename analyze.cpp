@@ -0,0 +1,365 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Replay analyzer: statistics over replay files written with -r (see
+ * ReplayLog.h).
+ *
+ * Every file is memory-mapped and split into runs of whole records, which
+ * are scanned on -j threads, each into its own totals; the totals are then
+ * added up. Players are matched by name, so files from contest and testAI
+ * can be mixed. Reported, as one JSON object on stdout:
+ *   - per player: games, wins, losses, ties, and the distribution of the
+ *     number of shots it took to win (outright wins of games played out;
+ *     a win because the other player couldn't place its ships has no shots);
+ *   - head to head: games, wins and ties for each pair that met;
+ *   - per board size and player: heat maps of how often each cell held one
+ *     of the player's ships (whole fleets only) and how often the player shot
+ *     at it.
+ * Usage: ./analyze [-j threads] file...
+ */
+
+#include <iostream>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// BattleShips project specific includes.
+#include "ReplayReader.h"
+#include "ThreadPool.h"
+#include "RunOptions.h"
+
+using namespace std;
+
+// Cells each player's ships covered and its shots hit, for one board size.
+struct HeatMaps {
+    vector<long long> placements;	// [player][cell], boardSize*boardSize cells a player.
+    vector<long long> shots;
+    vector<long long> games;		// [player]
+};
+
+struct PlayerStats {
+    long long games;
+    long long wins;
+    long long ties;
+    vector<long long> shotsToWin;	// Wins of games played out, by the number of shots taken.
+};
+
+// Everything counted over a run of records. Players are global ids.
+struct Totals {
+    long long games;
+    long long badRecords;
+    vector<PlayerStats> players;
+    vector<long long> pairGames;	// [player1*numPlayers + player2], player1 < player2
+    vector<long long> pairWins;		// [winner*numPlayers + loser]
+    vector<long long> pairTies;		// as pairGames
+    map<int, HeatMaps> heatMaps;	// by board size
+};
+
+struct ReplayFile {
+    string fileName;
+    ReplayReader reader;
+    vector<int> playerIds;		// The file's player ids to global ones.
+};
+
+void initTotals( Totals& totals );
+void scanRecords( const unsigned char* pos, const unsigned char* end, const vector<int>& playerIds, Totals& totals );
+HeatMaps& heatMapsFor( Totals& totals, int boardSize );
+void addTotals( Totals& total, Totals& part );
+void printResults( Totals& totals, int numFiles, double seconds );
+
+vector<string> allPlayerNames;		// Every player in any file, by global id.
+int numPlayers = 0;
+
+// Run size to scan as one job: small enough to keep every thread busy.
+const size_t PartBytes = 4 << 20;
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    if( optind >= argc ) {
+	cerr << "Usage: " << argv[0] << " [-j threads] replayFile..." << endl;
+	return 1;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<ReplayFile*> files;
+    for( int i=optind; i<argc; i++ ) {
+	ReplayFile* file = new ReplayFile;
+	file->fileName = argv[i];
+	if( ! file->reader.open(file->fileName) ) {
+	    return 1;
+	}
+	const vector<string>& names = file->reader.playerNames();
+	for( size_t id=0; id<names.size(); id++ ) {
+	    size_t global = 0;
+	    while( global < allPlayerNames.size() && allPlayerNames[global] != names[id] ) global++;
+	    if( global == allPlayerNames.size() ) allPlayerNames.push_back(names[id]);
+	    file->playerIds.push_back(global);
+	}
+	files.push_back(file);
+    }
+    numPlayers = allPlayerNames.size();
+
+    // One job, with its own totals, per run of records.
+    vector<Totals*> parts;
+    ThreadPool pool(options.numThreads);
+    for( size_t f=0; f<files.size(); f++ ) {
+	ReplayFile* file = files[f];
+	vector<size_t> offsets = file->reader.split(PartBytes);
+	if( offsets.back() != (size_t)(file->reader.end() - file->reader.begin()) ) {
+	    cerr << file->fileName << ": cut off after " << offsets.back() << " bytes of records" << endl;
+	}
+	for( size_t i=0; i+1<offsets.size(); i++ ) {
+	    Totals* part = new Totals;
+	    initTotals(*part);
+	    parts.push_back(part);
+	    const unsigned char* begin = file->reader.begin() + offsets[i];
+	    const unsigned char* end = file->reader.begin() + offsets[i+1];
+	    pool.submit( [begin, end, file, part]() {
+		scanRecords(begin, end, file->playerIds, *part);
+	    } );
+	}
+    }
+    pool.wait();
+
+    Totals totals;
+    initTotals(totals);
+    for( size_t i=0; i<parts.size(); i++ ) {
+	addTotals(totals, *parts[i]);
+	delete parts[i];
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printResults(totals, files.size(), seconds);
+
+    for( size_t f=0; f<files.size(); f++ ) {
+	delete files[f];
+    }
+    return 0;
+}
+
+void initTotals( Totals& totals ) {
+    totals.games = 0;
+    totals.badRecords = 0;
+    totals.players.assign(numPlayers, PlayerStats());
+    totals.pairGames.assign(numPlayers*numPlayers, 0);
+    totals.pairWins.assign(numPlayers*numPlayers, 0);
+    totals.pairTies.assign(numPlayers*numPlayers, 0);
+}
+
+HeatMaps& heatMapsFor( Totals& totals, int boardSize ) {
+    HeatMaps& maps = totals.heatMaps[boardSize];
+    if( maps.games.empty() ) {
+	maps.placements.assign((size_t)numPlayers * boardSize*boardSize, 0);
+	maps.shots.assign((size_t)numPlayers * boardSize*boardSize, 0);
+	maps.games.assign(numPlayers, 0);
+    }
+    return maps;
+}
+
+/**
+ * Adds up the records in [pos, end), which split() made sure are whole.
+ * The shots and placements are read straight out of the mapping.
+ */
+void scanRecords( const unsigned char* pos, const unsigned char* end, const vector<int>& playerIds, Totals& totals ) {
+    int lastBoardSize = -1;
+    HeatMaps* maps = NULL;
+    while( pos < end ) {
+	ReplayGame game;
+	if( ! readReplayGame(pos, end, game) ) {
+	    totals.badRecords++;
+	    return;
+	}
+	if( game.playerIds[0] >= (int)playerIds.size() || game.playerIds[1] >= (int)playerIds.size() ) {
+	    totals.badRecords++;
+	    continue;
+	}
+	int players[2] = { playerIds[game.playerIds[0]], playerIds[game.playerIds[1]] };
+	int size = game.boardSize;
+	int cells = size*size;
+	if( size != lastBoardSize ) {
+	    maps = &heatMapsFor(totals, size);
+	    lastBoardSize = size;
+	}
+	totals.games++;
+
+	// Results. A player that couldn't place all its ships forfeited, and
+	// the win it gave away says nothing about shooting.
+	bool won[2] = { (game.outcome & 1) != 0, (game.outcome & 2) != 0 };
+	bool fullFleet[2] = { game.numPlaced[0] == game.numShips, game.numPlaced[1] == game.numShips };
+	int shotsTaken[2] = { (game.numShots+1) / 2, game.numShots / 2 };
+	for( int side=0; side<2; side++ ) {
+	    PlayerStats& stats = totals.players[players[side]];
+	    stats.games++;
+	    if( won[side] && won[1-side] ) {
+		stats.ties++;
+	    } else if( won[side] ) {
+		stats.wins++;
+		if( ! fullFleet[0] || ! fullFleet[1] ) continue;
+		if( (int)stats.shotsToWin.size() <= shotsTaken[side] ) stats.shotsToWin.resize(shotsTaken[side]+1, 0);
+		stats.shotsToWin[shotsTaken[side]]++;
+	    } else if( ! won[1-side] ) {
+		stats.ties++;
+	    }
+	}
+	bool firstLow = players[0] <= players[1];
+	int low = firstLow ? players[0] : players[1];
+	int high = firstLow ? players[1] : players[0];
+	totals.pairGames[low*numPlayers + high]++;
+	if( won[0] == won[1] ) {
+	    totals.pairTies[low*numPlayers + high]++;
+	} else {
+	    int winner = won[0] ? players[0] : players[1];
+	    int loser = won[0] ? players[1] : players[0];
+	    totals.pairWins[winner*numPlayers + loser]++;
+	}
+
+	// Where the ships were; readReplayGame() has checked they fit.
+	for( int side=0; side<2; side++ ) {
+	    if( ! fullFleet[side] ) continue;
+	    long long* heat = &maps->placements[(size_t)players[side] * cells];
+	    const unsigned char* placement = game.placements[side];
+	    maps->games[players[side]]++;
+	    for( int i=0; i<game.numPlaced[side]; i++ ) {
+		int row, col;
+		bool horizontal;
+		nextPlacement(placement, size, row, col, horizontal);
+		int length = game.shipLengths[i];
+		int step = horizontal ? 1 : size;
+		for( int cell = row*size + col, j=0; j<length; j++, cell += step ) {
+		    heat[cell]++;
+		}
+	    }
+	}
+
+	// Where the shots went; the players take turns, player 1 first.
+	const unsigned char* shot = game.shots;
+	long long* heat[2] = { &maps->shots[(size_t)players[0] * cells], &maps->shots[(size_t)players[1] * cells] };
+	for( int i=0; i<game.numShots; i++ ) {
+	    int cell;
+	    ReplayResult result;
+	    nextShot(shot, cell, result);
+	    if( cell < cells ) heat[i & 1][cell]++;
+	}
+    }
+}
+
+static void addVector( vector<long long>& total, const vector<long long>& part ) {
+    if( total.size() < part.size() ) total.resize(part.size(), 0);
+    for( size_t i=0; i<part.size(); i++ ) {
+	total[i] += part[i];
+    }
+}
+
+void addTotals( Totals& total, Totals& part ) {
+    total.games += part.games;
+    total.badRecords += part.badRecords;
+    for( int p=0; p<numPlayers; p++ ) {
+	total.players[p].games += part.players[p].games;
+	total.players[p].wins += part.players[p].wins;
+	total.players[p].ties += part.players[p].ties;
+	addVector(total.players[p].shotsToWin, part.players[p].shotsToWin);
+    }
+    addVector(total.pairGames, part.pairGames);
+    addVector(total.pairWins, part.pairWins);
+    addVector(total.pairTies, part.pairTies);
+    for( map<int, HeatMaps>::iterator it = part.heatMaps.begin(); it != part.heatMaps.end(); ++it ) {
+	HeatMaps& maps = heatMapsFor(total, it->first);
+	addVector(maps.placements, it->second.placements);
+	addVector(maps.shots, it->second.shots);
+	addVector(maps.games, it->second.games);
+    }
+}
+
+/**
+ * Smallest number of shots with at least percent of the wins at or below it.
+ */
+static int percentile( const vector<long long>& histogram, long long total, double percent ) {
+    long long wanted = (long long)(percent / 100.0 * total + 0.5);
+    long long seen = 0;
+    for( size_t shots=0; shots<histogram.size(); shots++ ) {
+	seen += histogram[shots];
+	if( seen >= wanted && seen > 0 ) return shots;
+    }
+    return 0;
+}
+
+static void printHeatMap( const long long* heat, int size ) {
+    cout << "[";
+    for( int row=0; row<size; row++ ) {
+	cout << (row ? "," : "") << "[";
+	for( int col=0; col<size; col++ ) {
+	    cout << (col ? "," : "") << heat[row*size + col];
+	}
+	cout << "]";
+    }
+    cout << "]";
+}
+
+void printResults( Totals& totals, int numFiles, double seconds ) {
+    cerr << "Scanned " << totals.games << " games in " << seconds << " s" << endl;
+    cout << "{\"files\":" << numFiles << ",\"games\":" << totals.games
+	 << ",\"badRecords\":" << totals.badRecords << ",\"players\":[";
+    for( int p=0; p<numPlayers; p++ ) {
+	PlayerStats& stats = totals.players[p];
+	long long shots = 0, counted = 0;	// Forfeit wins aren't in shotsToWin.
+	for( size_t i=0; i<stats.shotsToWin.size(); i++ ) {
+	    shots += stats.shotsToWin[i] * (long long)i;
+	    counted += stats.shotsToWin[i];
+	}
+	cout << (p ? "," : "") << "{\"player\":" << jsonString(allPlayerNames[p])
+	     << ",\"games\":" << stats.games << ",\"wins\":" << stats.wins
+	     << ",\"losses\":" << stats.games - stats.wins - stats.ties << ",\"ties\":" << stats.ties
+	     << ",\"shotsToWin\":{\"mean\":" << (counted ? double(shots) / counted : 0)
+	     << ",\"p10\":" << percentile(stats.shotsToWin, counted, 10)
+	     << ",\"p50\":" << percentile(stats.shotsToWin, counted, 50)
+	     << ",\"p90\":" << percentile(stats.shotsToWin, counted, 90)
+	     << ",\"histogram\":[";
+	bool first = true;
+	for( size_t i=0; i<stats.shotsToWin.size(); i++ ) {
+	    if( stats.shotsToWin[i] == 0 ) continue;
+	    cout << (first ? "" : ",") << "[" << i << "," << stats.shotsToWin[i] << "]";
+	    first = false;
+	}
+	cout << "]}}";
+    }
+    cout << "],\"headToHead\":[";
+    bool first = true;
+    for( int a=0; a<numPlayers; a++ ) {
+	for( int b=a; b<numPlayers; b++ ) {
+	    long long games = totals.pairGames[a*numPlayers + b];
+	    if( games == 0 ) continue;
+	    cout << (first ? "" : ",") << "{\"player1\":" << jsonString(allPlayerNames[a])
+		 << ",\"player2\":" << jsonString(allPlayerNames[b]) << ",\"games\":" << games;
+	    if( a == b ) {
+		// A player against itself: the wins are both its own.
+		cout << ",\"player1Wins\":" << totals.pairWins[a*numPlayers + a] << ",\"player2Wins\":0";
+	    } else {
+		cout << ",\"player1Wins\":" << totals.pairWins[a*numPlayers + b]
+		     << ",\"player2Wins\":" << totals.pairWins[b*numPlayers + a];
+	    }
+	    cout << ",\"ties\":" << totals.pairTies[a*numPlayers + b] << "}";
+	    first = false;
+	}
+    }
+    cout << "],\"heatMaps\":[";
+    first = true;
+    for( map<int, HeatMaps>::iterator it = totals.heatMaps.begin(); it != totals.heatMaps.end(); ++it ) {
+	int size = it->first;
+	HeatMaps& maps = it->second;
+	for( int p=0; p<numPlayers; p++ ) {
+	    if( maps.games[p] == 0 ) continue;
+	    cout << (first ? "" : ",") << "{\"boardSize\":" << size << ",\"player\":" << jsonString(allPlayerNames[p])
+		 << ",\"games\":" << maps.games[p] << ",\"placements\":";
+	    printHeatMap(&maps.placements[(size_t)p * size*size], size);
+	    cout << ",\"shots\":";
+	    printHeatMap(&maps.shots[(size_t)p * size*size], size);
+	    cout << "}";
+	    first = false;
+	}
+    }
+    cout << "]}" << endl;
+}
@@ -0,0 +1,133 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Batch simulator driver: a match between two batch strategies (see
+ * BatchStrategies.h), played BatchLanes games at a time by BatchSimulator.
+ *
+ * Flags are the tester's: -b boardSize (3 to MAX_BOARD_SIZE), -g games,
+ * -s seed, -1 and -2 the strategies (0 Hunt Player, 1 Scan Strategy,
+ * 2 Density Strategy) and -j threads, each playing its own share of the
+ * games. The result is written to stdout as the tester's -q JSON, so
+ *	./batchsim -b 10 -g 1000 -s 7 -1 0 -2 1
+ *	./testAI -q -b 10 -g 1000 -s 7 -1 5 -2 6
+ * print the same line (the tester has each strategy as a BatchPlayer).
+ * How long the match took goes to stderr.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+#include "BatchSimulator.h"
+#include "BatchStrategies.h"
+#include "RunOptions.h"
+#include "SequentialTest.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+const int BatchLanes = 1024;		// Games played together by each simulator
+
+const int NumStrategies = 3;
+const char* strategyNames[NumStrategies] = {
+    "Hunt Player",
+    "Scan Strategy",
+    "Density Strategy"
+};
+
+int boardSize = MAX_BOARD_SIZE;
+int totalGames = 1000;
+uint64_t matchSeed = 0;
+
+template<class Strategy1, class Strategy2>
+void playGames( int firstGame, int numGames, BatchResult* result ) {
+    BatchSimulator<Strategy1, Strategy2> simulator(boardSize, numGames < BatchLanes ? numGames : BatchLanes);
+    simulator.play(matchSeed, firstGame, numGames, *result);
+}
+
+template<class Strategy1>
+void (*pickSecond( int strategy2 ))( int, int, BatchResult* ) {
+    switch( strategy2 ) {
+	default:
+	case 0: return playGames<Strategy1, HuntStrategy>;
+	case 1: return playGames<Strategy1, ScanStrategy>;
+	case 2: return playGames<Strategy1, DensityStrategy>;
+    }
+}
+
+/**
+ * @brief The match's game loop, compiled for this pair of strategies.
+ */
+void (*pickGames( int strategy1, int strategy2 ))( int, int, BatchResult* ) {
+    switch( strategy1 ) {
+	default:
+	case 0: return pickSecond<HuntStrategy>(strategy2);
+	case 1: return pickSecond<ScanStrategy>(strategy2);
+	case 2: return pickSecond<DensityStrategy>(strategy2);
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    if( options.boardSize > 0 ) boardSize = options.boardSize;
+    if( options.totalGames > 0 ) totalGames = options.totalGames;
+    matchSeed = options.haveSeed ? options.seed : time(NULL);
+    int strategies[2] = { options.player1, options.player2 };
+    for( int side=0; side<2; side++ ) {
+	if( strategies[side] < 0 || strategies[side] >= NumStrategies ) {
+	    cerr << "Pick the strategies with -1 and -2:" << endl;
+	    for( int i=0; i<NumStrategies; i++ ) {
+		cerr << "  " << i << ": " << strategyNames[i] << endl;
+	    }
+	    return 1;
+	}
+    }
+    if( boardSize < 3 || boardSize > MAX_BOARD_SIZE ) {
+	cerr << "Batch games are played on boards of 3 to " << MAX_BOARD_SIZE << endl;
+	return 1;
+    }
+
+    // An even share of the games for each thread, in whole blocks of lanes.
+    int numThreads = options.numThreads > 1 ? options.numThreads : 1;
+    int share = (totalGames + numThreads - 1) / numThreads;
+    share = (share + BatchLanes - 1) / BatchLanes * BatchLanes;
+    int numJobs = (totalGames + share - 1) / share;
+    vector<BatchResult> results(numJobs);
+    void (*games)( int, int, BatchResult* ) = pickGames(strategies[0], strategies[1]);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    {
+	ThreadPool pool(numThreads);
+	for( int job=0; job<numJobs; job++ ) {
+	    clearBatchResult(results[job]);
+	    int first = job * share;
+	    int count = totalGames - first < share ? totalGames - first : share;
+	    BatchResult* result = &results[job];
+	    pool.submit([=]() { games(first, count, result); });
+	}
+	pool.wait();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    BatchResult total;
+    clearBatchResult(total);
+    for( int job=0; job<numJobs; job++ ) {
+	addBatchResult(total, results[job]);
+    }
+
+    cout << "{\"boardSize\":" << boardSize << ",\"games\":" << total.games << ",\"players\":[";
+    for( int side=0; side<2; side++ ) {
+	cout << (side ? "," : "") << "{\"player\":" << jsonString(strategyNames[strategies[side]])
+	     << ",\"wins\":" << total.wins[side]
+	     << ",\"shotsTaken\":" << total.shotsTaken[side] << ",\"gamesCounted\":" << total.gamesCounted[side] << "}";
+    }
+    cout << "],\"ties\":" << total.ties
+	 << ",\"confidence\":" << SequentialTest::confidence(total.wins[0], total.wins[1])
+	 << ",\"stoppedEarly\":false}" << endl;
+    cerr << total.games << " games in " << seconds << " s (" << (int)(total.games / seconds) << " games/s)" << endl;
+    return 0;
+}
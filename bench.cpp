@@ -0,0 +1,354 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Benchmark driver: speed of every player pairing in PlayerTable.cpp.
+ *
+ * For each pair of players two headless matches are run with the same seed:
+ *   1. a plain match, timed as a whole, giving games per second and heap
+ *      allocations per game;
+ *   2. the same match with both players wrapped in a TimedPlayer, giving
+ *      nanosecond latency percentiles and allocation counts for newRound,
+ *      getMove, update and placeShip, summed per player over all pairings.
+ * Then the two targeting engines (see TargetingEngine.h) are timed on the same
+ * random positions at each game phase: a random fleet with a tenth, two
+ * tenths, ... of the board shot at random. This shows where the exact count
+ * becomes cheaper than sampling, and which one the engine ends up choosing.
+ * The setup section compares starting a round the old way, with a new
+ * AIContest and boards, against resetting one AIContest (per round, in
+ * microseconds and heap allocations; both include the players' newRound).
+ * Boards bigger than MAX_BOARD_SIZE only get the players that can play them
+ * (see playerMaxBoardSizes), each also against itself, and no targeting run.
+ * Results are written to stdout as one JSON object, so runs can be saved and
+ * compared. Flags: -b boardSize, -g games per pairing, -s seed, -l plugin
+ * (see PlayerPlugins.h), -x engine (see EnginePlayer.h); plugin and engine
+ * players are benched like the built-in ones, so an engine's numbers
+ * include the round trip to its process.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+// BattleShips project specific includes.
+#include "AIContest.h"
+#include "PlayerV2.h"
+#include "PlayerTable.h"
+#include "TimedPlayer.h"
+#include "AllocCounter.h"
+#include "ThreadRandom.h"
+#include "RunOptions.h"
+#include "TargetingEngine.h"
+#include "GameRandom.h"
+#include "PlacementTable.h"
+#include "PlayerPlugins.h"
+#include "USSWhite.h"		// For setTimedTargeting()
+
+using namespace std;
+
+// Throughput of one pairing.
+struct PairingResult {
+    int player1Id;
+    int player2Id;
+    double seconds;
+    long long moves;
+    long long allocations;
+};
+
+// Per-round cost of setting up a game.
+struct SetupResult {
+    double freshMicroseconds;	// New AIContest, reset, delete.
+    double reusedMicroseconds;	// reset() of one AIContest.
+    double freshAllocations;
+    double reusedAllocations;
+};
+
+// Targeting engine times for one game phase.
+struct PhaseResult {
+    int shots;
+    double samplerMicroseconds;
+    double exactMicroseconds;
+    double exactSolved;		// Share of positions the exact count finished.
+    double engineMicroseconds;
+    double engineExact;		// Share of positions the engine answered exactly.
+};
+
+PairingResult benchPairing( int player1Id, int player2Id );
+void timePairing( int player1Id, int player2Id );
+void playGames( PlayerV2* player1, int player1Id, PlayerV2* player2, int player2Id, long long& moves );
+SetupResult benchSetup();
+vector<PhaseResult> benchTargeting();
+void randomPosition( int shots, ShotEvidence& evidence );
+void printResults( const vector<PairingResult>& results, const SetupResult& setup, const vector<PhaseResult>& phases );
+
+int boardSize = MAX_BOARD_SIZE;
+int totalGames = 200;
+uint64_t benchSeed = 1;
+
+vector< vector<CallStats> > callStats;	// [player][PlayerCall], sized once the plugins are loaded
+
+// Targeting settings, as USSWhite uses them.
+const int SampleBudgetMicroseconds = 200;
+const long SamplesPerShot = 400;
+const int ExactCountStates = 1024;
+const int PositionsPerPhase = 50;
+const int FleetShips = 6;		// Most ships AIContest deals.
+const int SetupRounds = 10000;
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    if( options.boardSize > 0 ) boardSize = options.boardSize;
+    if( options.totalGames > 0 ) totalGames = options.totalGames;
+    if( options.haveSeed ) benchSeed = options.seed;
+    USSWhite::setTimedTargeting(options.timedTargeting);
+    if( boardSize < 3 || boardSize > MAX_LARGE_BOARD_SIZE ) {
+	cerr << "Board size must be 3-" << MAX_LARGE_BOARD_SIZE << endl;
+	return 1;
+    }
+    for( size_t i=0; i<options.plugins.size(); i++ ) {
+	if( ! loadPlayerPlugins(options.plugins[i]) ) return 1;
+    }
+    for( size_t i=0; i<options.engines.size(); i++ ) {
+	if( ! loadEnginePlayer(options.engines[i]) ) return 1;
+    }
+    addPluginPlayers();
+    int NumPlayers = numPlayers();
+    callStats.assign(NumPlayers, vector<CallStats>(NumPlayerCalls));
+
+    vector<PairingResult> results;
+    for( int i=0; i<NumPlayers; i++ ) {
+	// Few players go past MAX_BOARD_SIZE, so on large boards each also plays itself.
+	for( int j = boardSize > MAX_BOARD_SIZE ? i : i+1; j<NumPlayers; j++ ) {
+	    if( boardSize > playerMaxBoardSizes[i] || boardSize > playerMaxBoardSizes[j] ) continue;
+	    cerr << playerNames[i] << " vs " << playerNames[j] << endl;
+	    results.push_back(benchPairing(i, j));
+	    timePairing(i, j);
+	}
+    }
+    cerr << "Round setup" << endl;
+    SetupResult setup = benchSetup();
+    // The targeting engines work on CellMasks, which stop at MAX_BOARD_SIZE.
+    vector<PhaseResult> phases;
+    if( boardSize <= MAX_BOARD_SIZE ) {
+	cerr << "Targeting engines" << endl;
+	phases = benchTargeting();
+    }
+    printResults(results, setup, phases);
+    return 0;
+}
+
+/**
+ * Plays totalGames games between two fresh players and times the whole lot.
+ */
+PairingResult benchPairing( int player1Id, int player2Id ) {
+    PairingResult result;
+    result.player1Id = player1Id;
+    result.player2Id = player2Id;
+    result.moves = 0;
+
+    threadRandom::seed(threadRandom::deriveSeed(benchSeed, player1Id, player2Id));
+    PlayerV2* player1 = getPlayer(player1Id, boardSize);
+    PlayerV2* player2 = getPlayer(player2Id, boardSize);
+
+    long long allocations = allocationCount();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    playGames(player1, player1Id, player2, player2Id, result.moves);
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.allocations = allocationCount() - allocations;
+
+    delete player1;
+    delete player2;
+    return result;
+}
+
+/**
+ * Replays the same games with both players wrapped in TimedPlayers.
+ */
+void timePairing( int player1Id, int player2Id ) {
+    long long moves = 0;
+    threadRandom::seed(threadRandom::deriveSeed(benchSeed, player1Id, player2Id));
+    TimedPlayer player1(getPlayer(player1Id, boardSize), boardSize, callStats[player1Id].data());
+    TimedPlayer player2(getPlayer(player2Id, boardSize), boardSize, callStats[player2Id].data());
+    playGames(&player1, player1Id, &player2, player2Id, moves);
+}
+
+/**
+ * Plays the pairing's games; both passes get the same game seeds.
+ */
+void playGames( PlayerV2* player1, int player1Id, PlayerV2* player2, int player2Id, long long& moves ) {
+    AIContest game( player1, playerNames[player1Id], player2, playerNames[player2Id], boardSize );
+    for( int count=0; count<totalGames; count++ ) {
+	bool player1Won = false, player2Won = false;
+	int gameMoves = 0;
+	game.reset( gameSeed(benchSeed, player1Id*numPlayers() + player2Id, count), true, true );
+	game.play( 0, gameMoves, player1Won, player2Won );
+	moves += gameMoves;
+    }
+}
+
+/**
+ * Starts SetupRounds rounds with a new AIContest each, then as many by
+ * resetting one, between two copies of the first player that fits the board.
+ */
+SetupResult benchSetup() {
+    int playerId = 0;
+    while( playerId < numPlayers()-1 && boardSize > playerMaxBoardSizes[playerId] ) playerId++;
+    threadRandom::seed(threadRandom::deriveSeed(benchSeed, numPlayers(), 1));
+    PlayerV2* player1 = getPlayer(playerId, boardSize);
+    PlayerV2* player2 = getPlayer(playerId, boardSize);
+    string name = playerNames[playerId];
+    SetupResult result;
+
+    long long allocations = allocationCount();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for( int count=0; count<SetupRounds; count++ ) {
+	AIContest* game = new AIContest( player1, name, player2, name, boardSize );
+	game->reset( gameSeed(benchSeed, numPlayers()*numPlayers(), count), true, true );
+	delete game;
+    }
+    result.freshMicroseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / SetupRounds;
+    result.freshAllocations = double(allocationCount() - allocations) / SetupRounds;
+
+    AIContest game( player1, name, player2, name, boardSize );
+    allocations = allocationCount();
+    start = chrono::steady_clock::now();
+    for( int count=0; count<SetupRounds; count++ ) {
+	game.reset( gameSeed(benchSeed, numPlayers()*numPlayers(), count), true, true );
+    }
+    result.reusedMicroseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / SetupRounds;
+    result.reusedAllocations = double(allocationCount() - allocations) / SetupRounds;
+
+    delete player1;
+    delete player2;
+    return result;
+}
+
+static double microsecondsSince( chrono::steady_clock::time_point start ) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Times the sampler, the exact count and the engine that picks between them
+ * on PositionsPerPhase random positions per phase. The engine sees the phases
+ * in order twice and is timed the second time, once it has settled.
+ */
+vector<PhaseResult> benchTargeting() {
+    threadRandom::seed(threadRandom::deriveSeed(benchSeed, numPlayers()));
+    ShotSampler sampler(SampleBudgetMicroseconds, 1, SamplesPerShot);
+    PlacementCounter counter(ExactCountStates);
+    TargetingEngine engine(SampleBudgetMicroseconds, 1, SamplesPerShot, ExactCountStates);
+    long cellHits[CellCountSize];
+    double cellWeights[CellCountSize];
+
+    int cells = boardSize*boardSize;
+    vector<PhaseResult> phases;
+    for( int pass=0; pass<2; pass++ ) {
+	for( int phase=0; phase<TargetingEngine::NumPhases; phase++ ) {
+	    PhaseResult result = PhaseResult();
+	    result.shots = phase * cells / TargetingEngine::NumPhases;
+	    for( int i=0; i<PositionsPerPhase; i++ ) {
+		ShotEvidence evidence;
+		randomPosition(result.shots, evidence);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		engine.cellWeights(evidence, i, cellWeights);
+		result.engineMicroseconds += microsecondsSince(start);
+		result.engineExact += engine.lastMethod() == ExactTargeting;
+		if( pass == 0 ) continue;
+
+		start = chrono::steady_clock::now();
+		sampler.sample(evidence, i, cellHits);
+		result.samplerMicroseconds += microsecondsSince(start);
+		start = chrono::steady_clock::now();
+		result.exactSolved += counter.count(evidence, cellWeights);
+		result.exactMicroseconds += microsecondsSince(start);
+	    }
+	    if( pass == 0 ) continue;
+	    result.samplerMicroseconds /= PositionsPerPhase;
+	    result.exactMicroseconds /= PositionsPerPhase;
+	    result.exactSolved /= PositionsPerPhase;
+	    result.engineMicroseconds /= PositionsPerPhase;
+	    result.engineExact /= PositionsPerPhase;
+	    phases.push_back(result);
+	}
+    }
+    return phases;
+}
+
+/**
+ * A fleet dealt the way AIContest deals it, placed at random, with shots
+ * fired at random cells until the given number have been fired.
+ */
+void randomPosition( int shots, ShotEvidence& evidence ) {
+    int numShips = min(boardSize-2, FleetShips);
+    CellMask ships[MaxFleetShips];
+    int lengths[MaxFleetShips];
+    CellMask taken = outsideBoard(boardSize);
+    for( int i=0; i<numShips; i++ ) {
+	lengths[i] = random()%(MIN_SHIP_SIZE) + 3;
+	do {
+	    ships[i] = placementMask(lengths[i], random()%2, random()%boardSize, random()%boardSize);
+	} while( ships[i] & taken );
+	taken |= ships[i];
+    }
+
+    CellMask shot = 0;
+    while( cellCount(shot) < shots ) {
+	shot |= cellBit(random()%boardSize, random()%boardSize);
+    }
+
+    evidence.boardSize = boardSize;
+    evidence.misses = shot;
+    evidence.hits = 0;
+    evidence.sunk = 0;
+    evidence.numShips = 0;
+    for( int i=0; i<numShips; i++ ) {
+	evidence.misses &= ~ships[i];
+	if( (ships[i] & ~shot) == 0 ) {
+	    evidence.sunk |= ships[i];
+	} else {
+	    evidence.hits |= ships[i] & shot;
+	    evidence.shipLengths[evidence.numShips++] = lengths[i];
+	}
+    }
+}
+
+void printResults( const vector<PairingResult>& results, const SetupResult& setup, const vector<PhaseResult>& phases ) {
+    cout << "{\"boardSize\":" << boardSize << ",\"gamesPerPairing\":" << totalGames
+	 << ",\"seed\":" << benchSeed << ",\"pairings\":[";
+    for( size_t i=0; i<results.size(); i++ ) {
+	const PairingResult& result = results[i];
+	cout << (i ? "," : "") << "{\"player1\":" << jsonString(playerNames[result.player1Id])
+	     << ",\"player2\":" << jsonString(playerNames[result.player2Id])
+	     << ",\"seconds\":" << result.seconds
+	     << ",\"gamesPerSec\":" << (result.seconds > 0 ? totalGames / result.seconds : 0)
+	     << ",\"movesPerGame\":" << double(result.moves) / totalGames
+	     << ",\"allocsPerGame\":" << double(result.allocations) / totalGames << "}";
+    }
+    cout << "],\"players\":[";
+    for( int i=0; i<numPlayers(); i++ ) {
+	cout << (i ? "," : "") << "{\"player\":" << jsonString(playerNames[i])
+	     << ",\"plugin\":" << (i >= NumBuiltinPlayers ? "true" : "false") << ",\"calls\":{";
+	for( int call=0; call<NumPlayerCalls; call++ ) {
+	    cout << (call ? "," : "") << "\"" << playerCallNames[call] << "\":" << callStats[i][call].toJson();
+	}
+	cout << "}}";
+    }
+    cout << "],\"setup\":{\"rounds\":" << SetupRounds
+	 << ",\"freshMicros\":" << setup.freshMicroseconds
+	 << ",\"reusedMicros\":" << setup.reusedMicroseconds
+	 << ",\"freshAllocs\":" << setup.freshAllocations
+	 << ",\"reusedAllocs\":" << setup.reusedAllocations << "}";
+    cout << ",\"targeting\":[";
+    for( size_t i=0; i<phases.size(); i++ ) {
+	const PhaseResult& phase = phases[i];
+	cout << (i ? "," : "") << "{\"shots\":" << phase.shots
+	     << ",\"samplerMicros\":" << phase.samplerMicroseconds
+	     << ",\"exactMicros\":" << phase.exactMicroseconds
+	     << ",\"exactSolved\":" << phase.exactSolved
+	     << ",\"engineMicros\":" << phase.engineMicroseconds
+	     << ",\"engineExact\":" << phase.engineExact << "}";
+    }
+    cout << "]}" << endl;
+}
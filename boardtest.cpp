@@ -0,0 +1,157 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Differential test of BoardV3 against the original board in binaries.tar.
+ *
+ * Plays random boards on the original (BoardV0, see ReferenceBoard.h) and on
+ * both of today's boards, SmallBoard (from BoardV3::create()) and LargeBoard
+ * (made directly at the same small size). Every placement and shot must give
+ * the same return code and print the same diagnostics, and after each one
+ * every cell's opponent view, owner view and ship mark, and hasWon(), must
+ * match. Placements and shots include off-board, overlapping, bad-length and
+ * bad-direction ones, and today's boards are reused across games with
+ * clear(). Exits 1 at the first difference. Flags: -g boards, -s seed.
+ * Run as 'make boardtest'.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "BoardV3.h"
+#include "LargeBoard.h"
+#include "ReferenceBoard.h"
+#include "GameRandom.h"
+#include "RunOptions.h"
+
+using namespace std;
+
+long long placements = 0, shots = 0;
+
+/**
+ * Runs call with cerr sent to a string, and returns what was printed.
+ */
+template<class Call>
+string captureErrors( Call call ) {
+    ostringstream printed;
+    streambuf* old = cerr.rdbuf(printed.rdbuf());
+    call();
+    cerr.rdbuf(old);
+    return printed.str();
+}
+
+bool report( int game, const string& what, const string& board, int expected, int got ) {
+    cout << "boardtest: game " << game << ", " << what << ": " << board
+	 << " gave " << got << ", the original " << expected << endl;
+    return false;
+}
+
+bool sameViews( int game, const string& after, BoardV0& reference, BoardV3& board, const string& name, int size ) {
+    for( int row=0; row<size; row++ ) {
+	for( int col=0; col<size; col++ ) {
+	    const char* view = NULL;
+	    int expected = 0, got = 0;
+	    if( (got = board.getOpponentView(row, col)) != (expected = reference.getOpponentView(row, col)) ) {
+		view = " opponent view";
+	    } else if( (got = board.getOwnerView(row, col)) != (expected = reference.getOwnerView(row, col)) ) {
+		view = " owner view";
+	    } else if( (got = board.getShipMark(row, col)) != (expected = reference.getShipMark(row, col)) ) {
+		view = " ship mark";
+	    }
+	    if( view ) {
+		ostringstream cell;
+		cell << after << ", cell " << row << "," << col << view;
+		return report(game, cell.str(), name, expected, got);
+	    }
+	}
+    }
+    if( board.hasWon() != reference.hasWon() ) {
+	return report(game, after + ", hasWon", name, reference.hasWon(), board.hasWon());
+    }
+    return true;
+}
+
+/**
+ * @brief Plays one random game on the original and on boards[0..1].
+ */
+bool playGame( int game, GameRandom& random, int size, BoardV3* boards[2] ) {
+    const string names[2] = { "SmallBoard", "LargeBoard" };
+    BoardV0 reference(size);
+    for( int b=0; b<2; b++ ) boards[b]->clear();
+
+    int numShips = random.below(12);
+    for( int i=0; i<numShips; i++ ) {
+	int row = random.below(size+4) - 2;
+	int col = random.below(size+4) - 2;
+	int length = random.below(MAX_SHIP_SIZE+3) - 1;
+	Direction dir = Direction(random.below(3));
+	bool expected;
+	string expectedErrors = captureErrors([&]() { expected = reference.placeShip(row, col, length, dir); });
+	ostringstream what;
+	what << "placing " << length << " at " << row << "," << col << " dir " << dir;
+	for( int b=0; b<2; b++ ) {
+	    bool placed;
+	    string errors = captureErrors([&]() { placed = boards[b]->placeShip(row, col, length, dir); });
+	    if( placed != expected ) return report(game, what.str(), names[b], expected, placed);
+	    if( errors != expectedErrors ) {
+		cout << "boardtest: game " << game << ", " << what.str() << ": " << names[b] << " printed '"
+		     << errors << "', the original '" << expectedErrors << "'" << endl;
+		return false;
+	    }
+	    if( ! sameViews(game, what.str(), reference, *boards[b], names[b], size) ) return false;
+	}
+	placements++;
+    }
+
+    int numShots = random.below(2*size*size + 5);
+    for( int i=0; i<numShots; i++ ) {
+	int row = random.below(size+2) - 1;
+	int col = random.below(size+2) - 1;
+	char expected;
+	string expectedErrors = captureErrors([&]() { expected = reference.processShot(row, col); });
+	ostringstream what;
+	what << "shot " << i << " at " << row << "," << col;
+	for( int b=0; b<2; b++ ) {
+	    char result;
+	    string errors = captureErrors([&]() { result = boards[b]->processShot(row, col); });
+	    if( result != expected ) return report(game, what.str(), names[b], expected, result);
+	    if( errors != expectedErrors ) {
+		cout << "boardtest: game " << game << ", " << what.str() << ": " << names[b] << " printed '"
+		     << errors << "', the original '" << expectedErrors << "'" << endl;
+		return false;
+	    }
+	    if( ! sameViews(game, what.str(), reference, *boards[b], names[b], size) ) return false;
+	}
+	shots++;
+    }
+    return true;
+}
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    int games = options.totalGames > 0 ? options.totalGames : 20000;
+    GameRandom random(options.haveSeed ? options.seed : 1);
+
+    // One pair of today's boards per size, reused as AIContest reuses them.
+    BoardV3* boards[MAX_BOARD_SIZE+1][2];
+    for( int size=1; size<=MAX_BOARD_SIZE; size++ ) {
+	boards[size][0] = BoardV3::create(size);
+	boards[size][1] = new LargeBoard(size);
+    }
+    int game;
+    for( game=0; game<games; game++ ) {
+	int size = 1 + random.below(MAX_BOARD_SIZE);
+	if( ! playGame(game, random, size, boards[size]) ) break;
+    }
+    for( int size=1; size<=MAX_BOARD_SIZE; size++ ) {
+	delete boards[size][0];
+	delete boards[size][1];
+    }
+    if( game < games ) return 1;
+    cout << "boardtest: " << games << " boards, " << placements << " placements, " << shots
+	 << " shots: SmallBoard and LargeBoard match the original" << endl;
+    return 0;
+}
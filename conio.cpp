@@ -28,32 +28,31 @@ using namespace std;
  */
 namespace conio {
 
-    /** \brief Positions cursor to the specified row, col location.
-     *
-     * Gotoxy will position the cursor at the specified row,col location. The upper left corner
-     * has the coordinates 1,1. Note: this is row,col, not x,y (col,row) as is often done.
-     *
-     * \param row The row coordinate (1-based).
-     * \param col The column coordinate (1-based).
-     * \return Returns a string containing the escape sequence to send to the screen.
-     * gotoRowCol = CSI r;c
-     */
-    string gotoRowCol( const int row, const int col ) {
-	std::ostringstream strm;		// create the string stream
-	strm << CSI << row << ';' << col << 'H';	// insert the goodies
-	return strm.str();			// return a string with the info
-    }
-
     const int Foreground = 1;	// local implementation-specific values
     const int Background = 2;
 
-    string getColorSequence( Color c, int fgOrBg ) {
-	int BGOFFSET = 10;
-	int offset = 0;
-	if( fgOrBg == Background ) offset += BGOFFSET; 
+    /** \brief Writes n in decimal; returns the end of what was written. */
+    static char* putNumber( char* out, int n ) {
+	char digits[12];
+	int length = 0;
+	unsigned int u = n < 0 ? -(unsigned int)n : n;
+	do {
+	    digits[length++] = '0' + u % 10;
+	    u /= 10;
+	} while( u > 0 );
+	if( n < 0 ) *out++ = '-';
+	while( length > 0 ) *out++ = digits[--length];
+	return out;
+    }
 
-	std::ostringstream strm;	// create the string stream
-	//strm << CSI;
+    /** \brief Writes the CSI. */
+    static char* putCSI( char* out ) {
+	*out++ = CSI[0];
+	*out++ = CSI[1];
+	return out;
+    }
+
+    static bool validColor( Color c ) {
 	switch( c ) {
 	    case BLACK:
 	    case RED:
@@ -72,12 +71,98 @@ namespace conio {
 	    case LIGHT_MAGENTA:
 	    case LIGHT_CYAN:
 	    case WHITE:
-		strm << CSI << Color( c+offset ) << 'm';	// insert the goodies
-		break;
+		return true;
 	    default:
-		strm << "conio: invalid color: " << int(c) << endl;
+		return false;
+	}
+    }
+
+    static char* putColor( char* out, Color c, int fgOrBg ) {
+	int BGOFFSET = 10;
+	int offset = 0;
+	if( fgOrBg == Background ) offset += BGOFFSET; 
+
+	if( ! validColor(c) ) return out;
+	out = putCSI(out);
+	out = putNumber(out, c+offset);
+	*out++ = 'm';
+	return out;
+    }
+
+    /** \brief Writes the sequence that positions the cursor (see gotoRowCol()).
+     * \param out Where to write, with room for MAX_SEQUENCE chars.
+     * \return The end of the sequence written.
+     */
+    char* putRowCol( char* out, int row, int col ) {
+	out = putCSI(out);
+	out = putNumber(out, row);
+	*out++ = ';';
+	out = putNumber(out, col);
+	*out++ = 'H';
+	return out;
+    }
+
+    /** \brief Writes the sequence that sets the foreground color (see fgColor()). */
+    char* putFgColor( char* out, Color c ) {
+	return putColor( out, c, Foreground );
+    }
+
+    /** \brief Writes the sequence that sets the background color (see bgColor()). */
+    char* putBgColor( char* out, Color c ) {
+	return putColor( out, c, Background );
+    }
+
+    /** \brief Writes the sequence that sets the text style (see setTextStyle()). */
+    char* putTextStyle( char* out, TextStyle ts ) {
+	out = putCSI(out);
+	out = putNumber(out, ts);
+	*out++ = 'm';
+	return out;
+    }
+
+    /** \brief Writes one sequence for all the attributes (see conio.h). */
+    char* putAttributes( char* out, Color fg, Color bg, TextStyle ts ) {
+	out = putCSI(out);
+	*out++ = '0';
+	if( validColor(fg) ) {
+	    *out++ = ';';
+	    out = putNumber(out, fg);
+	}
+	if( validColor(bg) ) {
+	    *out++ = ';';
+	    out = putNumber(out, bg+10);
 	}
-	return strm.str();		// return a string with the info
+	if( ts ) {
+	    *out++ = ';';
+	    out = putNumber(out, ts);
+	}
+	*out++ = 'm';
+	return out;
+    }
+
+    /** \brief Positions cursor to the specified row, col location.
+     *
+     * Gotoxy will position the cursor at the specified row,col location. The upper left corner
+     * has the coordinates 1,1. Note: this is row,col, not x,y (col,row) as is often done.
+     *
+     * \param row The row coordinate (1-based).
+     * \param col The column coordinate (1-based).
+     * \return Returns a string containing the escape sequence to send to the screen.
+     * gotoRowCol = CSI r;c
+     */
+    string gotoRowCol( const int row, const int col ) {
+	char buffer[MAX_SEQUENCE];
+	return string( buffer, putRowCol(buffer, row, col) );
+    }
+
+    string getColorSequence( Color c, int fgOrBg ) {
+	if( ! validColor(c) ) {
+	    std::ostringstream strm;	// create the string stream
+	    strm << "conio: invalid color: " << int(c) << endl;
+	    return strm.str();
+	}
+	char buffer[MAX_SEQUENCE];
+	return string( buffer, putColor(buffer, c, fgOrBg) );
     }
 
     /** \brief Returns a string that contains the escape sequence to set the
@@ -107,9 +192,8 @@ namespace conio {
      *     to the terminal to set the text style.
      */
     string setTextStyle( TextStyle ts ) {
-	std::ostringstream strm;	// create the string stream
-	strm << CSI << ts << 'm';	// insert the goodies
-	return strm.str();		// return a string with the info
+	char buffer[MAX_SEQUENCE];
+	return string( buffer, putTextStyle(buffer, ts) );
     }
 
 
@@ -119,10 +203,7 @@ namespace conio {
      *     to the terminal to reset text output to the default.
      */
     string resetAll( ) {
-	std::ostringstream strm;	// create the string stream
-	strm << CSI << "0m";		// insert the goodies
-	return strm.str();		// return a string with the info
-
+	return RESET_ALL;
     }
 
     /** \brief Returns a string that contains the escape sequence to clear
@@ -131,9 +212,7 @@ namespace conio {
      *     to the terminal to clear the screen.
      */
     string clrscr() {
-	std::ostringstream strm;	// create the string stream
-	strm << CSI << "H" << CSI << "2J";		// insert the goodies
-	return strm.str();		// return a string with the info
+	return CLEAR_SCREEN;
     }
 
 }
@@ -45,6 +45,37 @@ namespace conio {
      */
     const char CSI[] = {'\033', '[', '\0'};
 
+    /**
+     * \brief The sequences that never change, ready to output as they are.
+     */
+    constexpr char RESET_ALL[] = "\033[0m";
+    constexpr char CLEAR_SCREEN[] = "\033[H\033[2J";
+
+    /**
+     * \brief Room for the longest sequence the put functions below write, in
+     * chars: putRowCol() with two 11-char ints is 26.
+     */
+    const int MAX_SEQUENCE = 32;
+
+    /**
+     * \brief These write the same sequences as the functions returning
+     * strings, but into the caller's buffer, which must have room for
+     * MAX_SEQUENCE chars. No terminating '\0' is written. They return the
+     * end of what was written, so calls can be chained, and never allocate.
+     * An invalid color writes nothing.
+     */
+    char* putRowCol( char* out, int row, int col );
+    char* putFgColor( char* out, Color c );
+    char* putBgColor( char* out, Color c );
+    char* putTextStyle( char* out, TextStyle ts );
+
+    /**
+     * \brief Writes one sequence that resets all the attributes, then sets
+     * the given colors and style: shorter than RESET_ALL followed by the
+     * three above. A 0 for any of them leaves it at the default.
+     */
+    char* putAttributes( char* out, Color fg, Color bg, TextStyle ts );
+
     string gotoRowCol( const int x, const int y );
     string fgColor( Color c );
     string bgColor( Color c );
@@ -11,6 +11,11 @@
 #include <iomanip>
 #include <cctype>
 #include <unistd.h>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 // Next 2 to access and setup the random number generator.
 #include <cstdlib>
@@ -21,6 +26,13 @@
 #include "AIContest.h"
 #include "PlayerV2.h"
 #include "conio.h"
+#include "ThreadPool.h"
+#include "ThreadRandom.h"
+#include "GameRandom.h"
+#include "RunOptions.h"
+#include "ReplayLog.h"
+#include "SequentialTest.h"
+#include "PlayerPlugins.h"
 
 // Include your player here
 //	Professor's contestants
@@ -29,8 +41,31 @@
 #include "GamblerPlayerV2.h"
 
 
+// One scheduled match between two players.
+struct Pairing {
+    int player1Id;
+    int player2Id;
+    bool checkLives;	// Skip the match if either player has been eliminated.
+};
+
+// Tallies from some or all of the rounds of one match.
+struct MatchResult {
+    int matchWins[2];
+    int ties;
+    int shotsTaken[2];
+    int gamesCounted[2];
+    int gamesPlayed;
+    PlayerTiming timing[2];	// Filled in when games are timed
+};
+
 PlayerV2* getPlayer( int playerId, int boardSize );
-void playMatch( int player1Id, int player2Id, bool showMoves );
+void runTournament( const vector<Pairing>& schedule, int numThreads );
+MatchResult playMatch( int pairingIndex, const Pairing& pairing, bool showMoves );
+MatchResult playRounds( int pairingIndex, const Pairing& pairing, int firstRound, int numRounds, bool showFirstRound );
+int numRoundBlocks( const Pairing& pairing );
+void addResult( MatchResult& total, const MatchResult& part );
+void reportMatch( const Pairing& pairing, const MatchResult& result );
+void printBatchSummary();
 int comparePlayers (const void * a, const void * b);
 
 using namespace std;
@@ -39,85 +74,189 @@ using namespace conio;
 float secondsPerMove = 1;
 int boardSize;	// BoardSize
 int totalGames = 0;
-int totalCountedMoves = 0;
-const int NumPlayers = 3;
-
-int wins[NumPlayers][NumPlayers];
-int playerIds[NumPlayers];
-int lives[NumPlayers];
-int winCount[NumPlayers];
-int statsShotsTaken[NumPlayers];
-int statsGamesCounted[NumPlayers];
-string playerNames[NumPlayers] = { 
+uint64_t tournamentSeed = 0;
+bool batchMode = false;		// No display, no pauses, JSON summary at the end.
+bool headlessGames = false;	// Games print nothing at all (batch mode or threads).
+ReplayWriter* replayLog = NULL;	// Every game is recorded here, if given (-r).
+SequentialTest earlyStop;	// Ends a match once its winner is settled (-e).
+bool timedGames = false;	// Time every call (-t, -m, -M).
+double moveLimit = 0;		// Seconds; 0 = none (-m)
+double gameLimit = 0;		// Seconds; 0 = none (-M)
+bool pipelinedMoves = false;	// Player 2 moves while player 1 hears its result (-o).
+const int NumBuiltinPlayers = 3;
+int NumPlayers = NumBuiltinPlayers;	// Plus the plugins (-l), which come after.
+
+// Rounds of a match between two round-independent players are played in
+// blocks of this many rounds, each with fresh player objects. Every game is
+// seeded from (tournament seed, match, round), so the blocks can run on
+// separate threads and still play the same games. With early stopping, such
+// a match is checked after each block, in block order; any other match after
+// each round.
+const int RoundBlockSize = 50;
+
+// Sized once the plugins are loaded.
+vector< vector<int> > wins;
+vector<int> playerIds;
+vector<int> lives;
+vector<int> winCount;
+vector<int> statsShotsTaken;
+vector<int> statsGamesCounted;
+vector<Pairing> matchesPlayed;	// In the order they were reported.
+vector<MatchResult> matchResults;
+vector<string> playerNames = { 
     "USSWhite",
     "Gambler Player",
     "Clean Player",
 };
 
+// Players that keep nothing from one round to the next (newRound() resets
+// everything they use). Only these may have their rounds split into blocks.
+vector<bool> roundIndependent = {
+    false,	// USSWhite learns across rounds
+    false,	// Gambler keeps its probe position across rounds
+    true,
+};
+
 
-int main() {
+int main( int argc, char* argv[] ) {
     //bool silent = false;
 
+    // Settings may come from the command line or a config file (see RunOptions.h).
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    batchMode = options.batch;
+    int numThreads = options.numThreads;
+    headlessGames = batchMode || numThreads > 1;
+    timedGames = options.timing;
+    moveLimit = options.moveLimit / 1000;
+    gameLimit = options.gameLimit / 1000;
+    pipelinedMoves = options.pipelined;
+    USSWhite::setTimedTargeting(options.timedTargeting);
+    if( pipelinedMoves && thread::hardware_concurrency() < 2 ) {
+	cerr << "Only one core: moves are not pipelined" << endl;
+    }
+
+    // Player plugins, then engines, join after the contest's own players (see PlayerPlugins.h).
+    for( size_t i=0; i<options.plugins.size(); i++ ) {
+	if( ! loadPlayerPlugins(options.plugins[i]) ) return 1;
+    }
+    for( size_t i=0; i<options.engines.size(); i++ ) {
+	if( ! loadEnginePlayer(options.engines[i]) ) return 1;
+    }
+    for( int i=0; i<numPlayerPlugins(); i++ ) {
+	const PlayerPluginInfo& plugin = playerPlugin(i);
+	if( plugin.maxBoardSize < MAX_BOARD_SIZE ) {
+	    cerr << plugin.name << " plays boards up to " << plugin.maxBoardSize
+		 << "; contest players must play up to " << MAX_BOARD_SIZE << endl;
+	    return 1;
+	}
+	playerNames.push_back(plugin.name);
+	roundIndependent.push_back(plugin.roundIndependent);
+    }
+    NumPlayers = playerNames.size();
+
     // Adjust based on the number of players!
     // Initialize various win statistics 
+    wins.assign(NumPlayers, vector<int>(NumPlayers, 0));
+    playerIds.resize(NumPlayers);
+    lives.resize(NumPlayers);
+    winCount.assign(NumPlayers, 0);
+    statsShotsTaken.assign(NumPlayers, 0);
+    statsGamesCounted.assign(NumPlayers, 0);
     for(int i=0; i<NumPlayers; i++) {
-	statsShotsTaken[i] = 0;
-	statsGamesCounted[i] = 0;
-	winCount[i] = 0;
 	lives[i] = NumPlayers/2;
 	playerIds[i] = i;
-	for(int j=0; j<NumPlayers; j++) {
-	    wins[i][j] = 0;
-    	}
     }
 
     // Seed (setup) the random number generator.
-    // This only needs to happen once per program run.
-    srand(time(NULL));
-
-    // Now to get the board size.
-    cout << "Welcome to the AI Bot contest." << endl << endl;
-    cout << "What size board would you like? [Anything other than numbers 3-10 exits.] ";
-    cin >> boardSize;
-    // If have invalid board size input (non-number, or 0-2, or > 10).
-    if ( !cin || boardSize < 3 || boardSize > 10 ) {
-	cout << "Exiting" << endl;
-	return 1;
-    }
+    // Every match is reseeded from the tournament seed, so the same seed
+    // gives the same standings whether or not matches run in parallel.
+    tournamentSeed = options.haveSeed ? options.seed : time(NULL);
+    srand(tournamentSeed);
+
+    // Batch mode never prompts: anything not given gets the contest default.
+    if( batchMode ) {
+	boardSize = options.boardSize > 0 ? options.boardSize : MAX_BOARD_SIZE;
+	totalGames = options.totalGames > 0 ? options.totalGames : 500;
+	secondsPerMove = 0;
+	// Every contest player keeps fixed-size arrays, so MAX_BOARD_SIZE is the limit.
+	if( boardSize < 3 || boardSize > MAX_BOARD_SIZE ) {
+	    cerr << "Board size must be 3-" << MAX_BOARD_SIZE << endl;
+	    return 1;
+	}
+    } else {
+	// Now to get the board size.
+	cout << "Welcome to the AI Bot contest." << endl << endl;
+	if( options.boardSize > 0 ) {
+	    boardSize = options.boardSize;
+	} else {
+	    cout << "What size board would you like? [Anything other than numbers 3-"
+		 << MAX_BOARD_SIZE << " exits.] ";
+	    cin >> boardSize;
+	}
+	// If have invalid board size input (non-number, or 0-2, or > MAX_BOARD_SIZE).
+	if ( !cin || boardSize < 3 || boardSize > MAX_BOARD_SIZE ) {
+	    cout << "Exiting" << endl;
+	    return 1;
+	}
 
-    // Find out how many times to test the AI.
-    cout << "How many times should I test the game AI? ";
-    cin >> totalGames;
+	// Find out how many times to test the AI.
+	if( options.totalGames > 0 ) {
+	    totalGames = options.totalGames;
+	} else {
+	    cout << "How many times should I test the game AI? ";
+	    cin >> totalGames;
+	}
 
-    cout << "The first game of each AI match is played at the specified speed," << endl
-	 << "all subsequent games are done without visual display." << endl
-	 << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
-    cin >> secondsPerMove;
+	if( numThreads > 1 ) {
+	    cout << "Playing matches on " << numThreads << " threads; games are not displayed." << endl;
+	} else if( options.secondsPerMove >= 0 ) {
+	    secondsPerMove = options.secondsPerMove;
+	} else {
+	    cout << "The first game of each AI match is played at the specified speed," << endl
+		 << "all subsequent games are done without visual display." << endl
+		 << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
+	    cin >> secondsPerMove;
+	}
+	cout << "Tournament seed: " << tournamentSeed << endl;
+    }
 
-    // And now it's show time!
+    // Build the schedule in the order the matches are played.
+    vector<Pairing> schedule;
     int offset=1;
     //int player=0;
     while( offset<NumPlayers/2 ) {
 	for( int player=0; player+offset<NumPlayers; player+=offset+1 ) {
-	    playMatch(player, player+offset, true);
-	    usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	    Pairing pairing = { player, player+offset, false };
+	    schedule.push_back(pairing);
 	}
 	++offset;
     }
     for( int player1Id=0; player1Id<NumPlayers; player1Id++ ) {
 	for( int player2Id=player1Id+1; player2Id<NumPlayers; player2Id++ ) {
-
 	    // Don't play anybody who has been eliminated
-	    if(lives[player1Id] == 0 || lives[player2Id] == 0) continue;
-
-	    playMatch(player1Id, player2Id, true);
-	    usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	    Pairing pairing = { player1Id, player2Id, true };
+	    schedule.push_back(pairing);
 	}
     }
-    cout << endl << endl;
+
+    earlyStop = SequentialTest(options.stopError);
+
+    // Record the games if asked; deleting the writer flushes the file.
+    if( ! options.replayFile.empty() ) {
+	replayLog = new ReplayWriter(options.replayFile, playerNames.data(), NumPlayers);
+	if( ! replayLog->ok() ) return 1;
+    }
+
+    // And now it's show time!
+    runTournament(schedule, numThreads);
+    delete replayLog;
+    replayLog = NULL;
 
     // Now calculate contest results
-    qsort (playerIds, NumPlayers, sizeof(int), comparePlayers);
+    qsort (playerIds.data(), NumPlayers, sizeof(int), comparePlayers);
 
     // Add up the total wins per player
     for( int i=0; i<NumPlayers; i++ ) {
@@ -125,6 +264,12 @@ int main() {
 	    winCount[i]+= wins[i][j];
     }
 
+    if( batchMode ) {
+	printBatchSummary();
+	return 0;
+    }
+    cout << endl << endl;
+
     // TESTING for TIE
     //winCount[playerIds[1]] = winCount[playerIds[0]];
     //lives[playerIds[1]] = lives[playerIds[0]];
@@ -158,72 +303,266 @@ int main() {
     return 0;
 }
 
-void playMatch( int player1Id, int player2Id, bool showMoves ) {
+/**
+ * Plays every match in the schedule and reports them in schedule order.
+ *
+ * With more than one thread, a match is started as soon as every earlier match
+ * that involves either of its players has been reported, because only those
+ * matches can change the lives it is checked against. Results are always
+ * reported in schedule order, so the standings match a single-threaded run.
+ */
+void runTournament( const vector<Pairing>& schedule, int numThreads ) {
+    int numMatches = schedule.size();
+
+    if( numThreads <= 1 ) {
+	for( int i=0; i<numMatches; i++ ) {
+	    const Pairing& pairing = schedule[i];
+	    if( pairing.checkLives && (lives[pairing.player1Id] == 0 || lives[pairing.player2Id] == 0) ) {
+		continue;
+	    }
+	    reportMatch(pairing, playMatch(i, pairing, ! batchMode));
+	    if( ! batchMode ) {
+		usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	    }
+	}
+	return;
+    }
+
+    enum Status { Waiting, Running, Finished, Reported };
+    vector<int> status(numMatches, Waiting);
+    vector<MatchResult> results(numMatches);
+    // Blocks are added into results in block order, so a match that stops
+    // early stops after the same block whatever order they finish in.
+    vector< vector<MatchResult> > blockResults(numMatches);
+    vector< vector<bool> > blockDone(numMatches);
+    vector<int> blocksAdded(numMatches, 0);
+    mutex lock;
+    condition_variable matchFinished;
+    ThreadPool pool(numThreads);
+
+    int nextToReport = 0;
+    unique_lock<mutex> guard(lock);
+    while( nextToReport < numMatches ) {
+	// Start everything whose earlier matches with the same players are reported.
+	for( int i=nextToReport; i<numMatches; i++ ) {
+	    if( status[i] != Waiting ) continue;
+	    const Pairing& pairing = schedule[i];
+	    bool ready = true;
+	    for( int j=nextToReport; j<i && ready; j++ ) {
+		bool sharesPlayer = schedule[j].player1Id == pairing.player1Id || schedule[j].player1Id == pairing.player2Id
+		                 || schedule[j].player2Id == pairing.player1Id || schedule[j].player2Id == pairing.player2Id;
+		ready = ! sharesPlayer || status[j] == Reported;
+	    }
+	    if( ! ready ) continue;
+
+	    if( pairing.checkLives && (lives[pairing.player1Id] == 0 || lives[pairing.player2Id] == 0) ) {
+		status[i] = Reported;	// Eliminated: nothing to play or report.
+		continue;
+	    }
+
+	    status[i] = Running;
+	    results[i] = MatchResult();
+	    int numBlocks = numRoundBlocks(pairing);
+	    blockResults[i].assign(numBlocks, MatchResult());
+	    blockDone[i].assign(numBlocks, false);
+	    blocksAdded[i] = 0;
+	    for( int block=0; block<numBlocks; block++ ) {
+		int numRounds = numBlocks == 1 ? totalGames : min(RoundBlockSize, totalGames - block*RoundBlockSize);
+		int firstRound = block*RoundBlockSize;
+		pool.submit( [&, i, block, numBlocks, firstRound, numRounds]() {
+		    {
+			unique_lock<mutex> startGuard(lock);
+			if( status[i] != Running ) return;	// Settled by the blocks before.
+		    }
+		    MatchResult part = playRounds(i, schedule[i], firstRound, numRounds, false);
+		    unique_lock<mutex> doneGuard(lock);
+		    if( status[i] != Running ) return;
+		    blockResults[i][block] = part;
+		    blockDone[i][block] = true;
+		    bool settled = false;
+		    while( blocksAdded[i] < numBlocks && blockDone[i][blocksAdded[i]] && ! settled ) {
+			addResult(results[i], blockResults[i][blocksAdded[i]++]);
+			settled = earlyStop.settled(results[i].matchWins[0], results[i].matchWins[1]);
+		    }
+		    if( settled || blocksAdded[i] == numBlocks ) {
+			status[i] = Finished;
+			matchFinished.notify_one();
+		    }
+		});
+	    }
+	}
+
+	// Report finished matches in schedule order.
+	while( nextToReport < numMatches && status[nextToReport] == Reported ) {
+	    nextToReport++;
+	}
+	if( nextToReport == numMatches ) break;
+	while( status[nextToReport] != Finished ) {
+	    matchFinished.wait(guard);
+	}
+	reportMatch(schedule[nextToReport], results[nextToReport]);
+	status[nextToReport] = Reported;
+    }
+    guard.unlock();
+    pool.wait();
+}
+
+/**
+ * Number of blocks, each with its own players, the rounds of a match are split into.
+ */
+int numRoundBlocks( const Pairing& pairing ) {
+    if( ! roundIndependent[pairing.player1Id] || ! roundIndependent[pairing.player2Id] ) {
+	return 1;
+    }
+    return max(1, (totalGames + RoundBlockSize - 1) / RoundBlockSize);
+}
+
+/**
+ * Plays all rounds of a match on the calling thread, block by block.
+ */
+MatchResult playMatch( int pairingIndex, const Pairing& pairing, bool showMoves ) {
+    MatchResult result = MatchResult();
+    int numBlocks = numRoundBlocks(pairing);
+    for( int block=0; block<numBlocks; block++ ) {
+	int numRounds = numBlocks == 1 ? totalGames : min(RoundBlockSize, totalGames - block*RoundBlockSize);
+	addResult(result, playRounds(pairingIndex, pairing, block*RoundBlockSize, numRounds, showMoves && block == 0));
+	if( earlyStop.settled(result.matchWins[0], result.matchWins[1]) ) break;
+    }
+    return result;
+}
+
+/**
+ * Plays rounds firstRound.. of a match with a fresh pair of players. Safe to
+ * call from several threads at once: it only touches its own players and the
+ * calling thread's random number generator. A match played in one block
+ * stops as soon as earlyStop says it is settled.
+ */
+MatchResult playRounds( int pairingIndex, const Pairing& pairing, int firstRound, int numRounds, bool showFirstRound ) {
     PlayerV2 *player1, *player2;
-    AIContest *game;
-    int matchWins[2] = {0, 0};
+    MatchResult result = MatchResult();
     bool player1Won=false, player2Won=false;
-    int player1Ties=0, player2Ties=0;
+    int totalCountedMoves = 0;
+    int player1Id = pairing.player1Id;
+    int player2Id = pairing.player2Id;
 
+    // For anything the constructors draw; each game is reseeded by AIContest.
+    threadRandom::seed(gameSeed(tournamentSeed, pairingIndex, firstRound));
     player1 = getPlayer(player1Id, boardSize);
     player2 = getPlayer(player2Id, boardSize);
+    // One referee and pair of boards for all the rounds.
+    AIContest game( player1, playerNames[player1Id],
+		    player2, playerNames[player2Id], boardSize );
+    game.setReplay(replayLog, player1Id, player2Id);
+    if( timedGames ) {
+	game.setTiming(moveLimit, gameLimit, &result.timing[0], &result.timing[1]);
+    }
+    game.setPipelined(pipelinedMoves);	// main() warns if it can't be
 
     bool silent = true;
-    for( int count=0; count<totalGames; count++ ) {
+    for( int count=0; count<numRounds; count++ ) {
 	player1Won = false; player2Won = false;
-	player1->newRound();
-	player2->newRound();
+	uint64_t seed = gameSeed(tournamentSeed, pairingIndex, firstRound + count);
 
-	if( count==0 ) {
+	if( count==0 && showFirstRound ) {
 	    silent = false;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-				  boardSize, silent );
-	    game->play( secondsPerMove, totalCountedMoves, player1Won, player2Won );
+	    game.reset( seed, silent );
+	    game.play( secondsPerMove, totalCountedMoves, player1Won, player2Won );
 	} 
 	else {
 	    silent = true;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-		      boardSize, silent );
-	    game->play( 0, totalCountedMoves, player1Won, player2Won );
+	    game.reset( seed, silent, headlessGames );
+	    game.play( 0, totalCountedMoves, player1Won, player2Won );
 	}
 	if((player1Won && player2Won) || !(player1Won || player2Won)) {
-	    player1Ties++;
-	    player2Ties++;
-	    statsShotsTaken[player1Id] += totalCountedMoves;
-	    statsGamesCounted[player1Id]++;
-	    statsShotsTaken[player2Id] += totalCountedMoves;
-	    statsGamesCounted[player2Id]++;
+	    result.ties++;
+	    result.shotsTaken[0] += totalCountedMoves;
+	    result.gamesCounted[0]++;
+	    result.shotsTaken[1] += totalCountedMoves;
+	    result.gamesCounted[1]++;
 	} else if( player1Won ) {
-	    matchWins[0]++;
-	    wins[player1Id][player2Id]++;
-	    statsShotsTaken[player1Id] += totalCountedMoves;
-	    statsGamesCounted[player1Id]++;
+	    result.matchWins[0]++;
+	    result.shotsTaken[0] += totalCountedMoves;
+	    result.gamesCounted[0]++;
 	} else if( player2Won ) {
-	    matchWins[1]++;
-	    wins[player2Id][player1Id]++;
-	    statsShotsTaken[player2Id] += totalCountedMoves;
-	    statsGamesCounted[player2Id]++;
+	    result.matchWins[1]++;
+	    result.shotsTaken[1] += totalCountedMoves;
+	    result.gamesCounted[1]++;
 	}
-	delete game;
+	result.gamesPlayed++;
+	if( numRounds == totalGames && earlyStop.settled(result.matchWins[0], result.matchWins[1]) ) break;
     }
     delete player1;
     delete player2;
 
+    return result;
+}
+
+void addResult( MatchResult& total, const MatchResult& part ) {
+    total.ties += part.ties;
+    total.gamesPlayed += part.gamesPlayed;
+    for( int side=0; side<2; side++ ) {
+	total.matchWins[side] += part.matchWins[side];
+	total.shotsTaken[side] += part.shotsTaken[side];
+	total.gamesCounted[side] += part.gamesCounted[side];
+	total.timing[side].add(part.timing[side]);
+    }
+}
+
+/**
+ * Adds a finished match into the tournament statistics and prints its summary.
+ * Only ever called from the main thread.
+ */
+void reportMatch( const Pairing& pairing, const MatchResult& result ) {
+    int player1Id = pairing.player1Id;
+    int player2Id = pairing.player2Id;
+    const int* matchWins = result.matchWins;
+    int player1Ties = result.ties, player2Ties = result.ties;
+
+    wins[player1Id][player2Id] += matchWins[0];
+    wins[player2Id][player1Id] += matchWins[1];
+    statsShotsTaken[player1Id] += result.shotsTaken[0];
+    statsGamesCounted[player1Id] += result.gamesCounted[0];
+    statsShotsTaken[player2Id] += result.shotsTaken[1];
+    statsGamesCounted[player2Id] += result.gamesCounted[1];
+    matchesPlayed.push_back(pairing);
+    matchResults.push_back(result);
+
+    if( batchMode ) {
+	if(wins[player1Id][player2Id] > wins[player2Id][player1Id]) {
+	    lives[player2Id]--;
+	} else if(wins[player1Id][player2Id] < wins[player2Id][player1Id]) {
+	    lives[player1Id]--;
+	} else {
+	    lives[player1Id]--;
+	    lives[player2Id]--;
+	}
+	return;
+    }
+
     cout << endl << "********************" << endl;
     cout << playerNames[player1Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[0] << resetAll()
-	 << " losses=" << totalGames-matchWins[0]-player1Ties 
+	 << " losses=" << result.gamesPlayed-matchWins[0]-player1Ties 
 	 << " ties=" << player1Ties << " (cumulative avg. shots/game = "
 	 << (statsGamesCounted[player1Id]==0 ? 0.0 : 
 	    (float)statsShotsTaken[player1Id]/(float)statsGamesCounted[player1Id])
 	 << ")" << endl;
     cout << playerNames[player2Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[1] << resetAll()
-	 << " losses=" << totalGames-matchWins[1]-player2Ties 
+	 << " losses=" << result.gamesPlayed-matchWins[1]-player2Ties 
 	 << " ties=" << player2Ties << " (cumulative avg. shots/game = "
 	 << (statsGamesCounted[player2Id]==0 ? 0.0 : 
 	    (float)statsShotsTaken[player2Id]/(float)statsGamesCounted[player2Id])
 	 << ")" << endl;
+    cout << "Games played=" << result.gamesPlayed << " of " << totalGames << ", confidence in the leader="
+	 << (int)(1000 * SequentialTest::confidence(matchWins[0], matchWins[1]) + 0.5) / 10.0 << "%" << endl;
+    if( timedGames ) {
+	int ids[2] = { player1Id, player2Id };
+	for( int side=0; side<2; side++ ) {
+	    const PlayerTiming& timing = result.timing[side];
+	    cout << playerNames[ids[side]] << ": getMove " << timing.getMove.toText()
+		 << "; update " << timing.update.toText()
+		 << "; late moves=" << timing.lateMoves << " time forfeits=" << timing.timeForfeits << endl;
+	}
+    }
     cout << "********************" << endl;
 
     cout << setTextStyle( NEGATIVE_IMAGE );
@@ -255,6 +594,35 @@ void playMatch( int player1Id, int player2Id, bool showMoves ) {
     cout << resetAll() << "********************" << endl;
 }
 
+/**
+ * Prints the final standings and every match result as one JSON object.
+ */
+void printBatchSummary() {
+    cout << "{\"boardSize\":" << boardSize << ",\"gamesPerMatch\":" << totalGames
+	 << ",\"seed\":" << tournamentSeed << ",\"standings\":[";
+    for( int i=0; i<NumPlayers; i++ ) {
+	int id = playerIds[i];
+	cout << (i ? "," : "") << "{\"player\":" << jsonString(playerNames[id])
+	     << ",\"lives\":" << lives[id] << ",\"wins\":" << winCount[id]
+	     << ",\"shotsTaken\":" << statsShotsTaken[id] << ",\"gamesCounted\":" << statsGamesCounted[id] << "}";
+    }
+    cout << "],\"matches\":[";
+    for( size_t i=0; i<matchesPlayed.size(); i++ ) {
+	const MatchResult& result = matchResults[i];
+	cout << (i ? "," : "") << "{\"player1\":" << jsonString(playerNames[matchesPlayed[i].player1Id])
+	     << ",\"player2\":" << jsonString(playerNames[matchesPlayed[i].player2Id])
+	     << ",\"games\":" << result.gamesPlayed
+	     << ",\"wins1\":" << result.matchWins[0] << ",\"wins2\":" << result.matchWins[1]
+	     << ",\"ties\":" << result.ties
+	     << ",\"confidence\":" << SequentialTest::confidence(result.matchWins[0], result.matchWins[1]);
+	if( timedGames ) {
+	    cout << ",\"timing\":[" << result.timing[0].toJson() << "," << result.timing[1].toJson() << "]";
+	}
+	cout << "}";
+    }
+    cout << "]}" << endl;
+}
+
 int comparePlayers (const void * a, const void * b) {
     int p1 = *(int*)a;
     int p2 = *(int*)b;
@@ -268,6 +636,9 @@ int comparePlayers (const void * a, const void * b) {
 }
 
 PlayerV2* getPlayer( int playerId, int boardSize ) {
+    if( playerId >= NumBuiltinPlayers ) {
+	return createPluginPlayer(playerId - NumBuiltinPlayers, boardSize);
+    }
     switch( playerId ) {
 	// Professor provided
 	default:
@@ -0,0 +1,144 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Checks PlacementCounter against brute force.
+ *
+ * Makes random positions the way a game reaches them: a fleet of up to
+ * CountTestShips ships on a board of 3 to CountTestMaxSize, with random
+ * cells shot, turned into misses, hits and sunk ships (ShotEvidence). For
+ * each, every ordered placing of the ships still afloat is tried, keeping
+ * those that miss the misses, the sunk ships and each other and cover every
+ * hit, and each cell's chance is the share of those that cover it. The
+ * counter's chances must agree to 1e-9 on every cell, and it must fail
+ * exactly when nothing fits. The ship lengths come in random order, since
+ * count() has to sort them itself. Exits 1 at the first difference.
+ * Flags: -g positions, -s seed. Run as 'make counttest'.
+ */
+
+#include <iostream>
+#include <cmath>
+
+#include "PlacementCounter.h"
+#include "ShotEvidence.h"
+#include "CellMask.h"
+#include "GameRandom.h"
+#include "RunOptions.h"
+
+using namespace std;
+
+const int CountTestShips = 4;
+const int CountTestMaxSize = 7;
+
+/**
+ * @brief Adds to cellWays every fitting way to place ships depth.. of
+ * evidence, given the cells taken so far. Returns how many there are.
+ */
+double bruteForce( const ShotEvidence& evidence, int depth, CellMask taken, CellMask blocked, double cellWays[CellCountSize] ) {
+    if( depth == evidence.numShips ) {
+	if( evidence.hits & ~taken ) return 0;
+	for( CellMask cells = taken & ~evidence.sunk; cells != 0; cells &= cells - 1 ) {
+	    cellWays[firstCell(cells)]++;
+	}
+	return 1;
+    }
+    double ways = 0;
+    for( int horiz=0; horiz<2; horiz++ ) {
+	for( int row=0; row<evidence.boardSize; row++ ) {
+	    for( int col=0; col<evidence.boardSize; col++ ) {
+		CellMask ship = placementMask(evidence.shipLengths[depth], horiz, row, col);
+		if( ship & (taken | blocked) ) continue;
+		ways += bruteForce(evidence, depth+1, taken | ship, blocked, cellWays);
+	    }
+	}
+    }
+    return ways;
+}
+
+/**
+ * @brief A random fleet on a random board with some of it shot at.
+ */
+void randomPosition( GameRandom& random, ShotEvidence& evidence ) {
+    int size = 3 + random.below(CountTestMaxSize - 2);
+    int numShips = 1 + random.below(CountTestShips);
+    CellMask ships[CountTestShips];
+    int lengths[CountTestShips];
+    CellMask taken = outsideBoard(size);
+    for( int i=0; i<numShips; i++ ) {
+	lengths[i] = 1 + random.below(size < MAX_SHIP_SIZE ? size : MAX_SHIP_SIZE);
+	int tries = 0;
+	do {
+	    ships[i] = placementMask(lengths[i], random.below(2), random.below(size), random.below(size));
+	} while( (ships[i] & taken) && ++tries < 1000 );
+	if( ships[i] & taken ) {
+	    numShips = i;	// No room left; play with the ships so far.
+	    break;
+	}
+	taken |= ships[i];
+    }
+
+    CellMask shot = 0;
+    int shots = random.below(size*size);
+    for( int i=0; i<shots; i++ ) {
+	shot |= cellBit(random.below(size), random.below(size));
+    }
+
+    evidence.boardSize = size;
+    evidence.misses = shot;
+    evidence.hits = 0;
+    evidence.sunk = 0;
+    evidence.numShips = 0;
+    for( int i=0; i<numShips; i++ ) {
+	evidence.misses &= ~ships[i];
+	if( (ships[i] & ~shot) == 0 ) {
+	    evidence.sunk |= ships[i];
+	} else {
+	    evidence.hits |= ships[i] & shot;
+	    evidence.shipLengths[evidence.numShips++] = lengths[i];
+	}
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    int positions = options.totalGames > 0 ? options.totalGames : 300;
+    GameRandom random(options.haveSeed ? options.seed : 1);
+    PlacementCounter counter(1 << 20);
+    int counted = 0;
+
+    for( int i=0; i<positions; i++ ) {
+	ShotEvidence evidence;
+	randomPosition(random, evidence);
+	double chance[CellCountSize];
+	bool ok = counter.count(evidence, chance);
+
+	double cellWays[CellCountSize] = {0};
+	CellMask blocked = evidence.misses | evidence.sunk | outsideBoard(evidence.boardSize);
+	double total = evidence.numShips > 0 ? bruteForce(evidence, 0, 0, blocked, cellWays) : 0;
+	if( ok != (total > 0) ) {
+	    cout << "counttest: position " << i << ": count() returned " << ok
+		 << " with " << total << " fitting fleets" << endl;
+	    return 1;
+	}
+	if( ! ok ) continue;
+	counted++;
+	for( int row=0; row<evidence.boardSize; row++ ) {
+	    for( int col=0; col<evidence.boardSize; col++ ) {
+		int cell = row*CellMaskStride + col;
+		// Hits are certain, but count() only reports unshot cells.
+		double expected = hasCell(evidence.hits, row, col) ? 0 : cellWays[cell] / total;
+		if( fabs(chance[cell] - expected) > 1e-9 ) {
+		    cout << "counttest: position " << i << " (board " << evidence.boardSize << ", "
+			 << evidence.numShips << " ships), cell " << row << "," << col << ": count() gave "
+			 << chance[cell] << ", brute force " << expected << endl;
+		    return 1;
+		}
+	    }
+	}
+    }
+    cout << "counttest: " << positions << " positions (" << counted
+	 << " with fitting fleets): PlacementCounter matches brute force" << endl;
+    return 0;
+}
@@ -29,7 +29,8 @@ using namespace std;
     const char PEEK = 'P';
     const char PLACE_SHIP = 'Z';
 
-    const int MAX_BOARD_SIZE = 10;
+    const int MAX_BOARD_SIZE = 10;	// Largest board for players with fixed-size arrays (PlayerV2).
+    const int MAX_LARGE_BOARD_SIZE = 200;	// Largest board AIContest can run.
     const int MAX_SHIP_SIZE = 5;
     const int MIN_SHIP_SIZE = 3;
 
@@ -0,0 +1,193 @@
+/**
+ * @author Mitchell Toth
+ * @date October, 2026
+ * Checks that USSWhite's incremental probability board picks the same shots
+ * as recounting it from scratch every move.
+ *
+ * Two USSWhites play in lockstep, one keeping probabilityBoard current from
+ * notify() and one recounting it before every shot (setShotModes()), with the
+ * same random streams. Each round a fleet is dealt as AIContest deals it and
+ * placed at random on a board that both shoot at, and both are told the
+ * results as AIContest tells them. Every shot the two pick must be the same.
+ * Each player plays DensityTestRounds rounds in a row, so the learned scan
+ * bonus (from the third round on) is covered. This runs with fleet targeting
+ * off, so the scan picks the hunting shots from the board, and again with it
+ * on. Exits 1 at the first difference.
+ * Timed fleet targeting (USSWhite::setTimedTargeting()) can't be compared
+ * shot for shot, since its shots depend on the clock. It is played last, on
+ * its own, and only has to shoot on the board, never at a cell twice, and
+ * sink the fleet.
+ * Flags: -g rounds per board size and mode, -s seed. Run as 'make densitytest'.
+ */
+
+#include <iostream>
+
+#include "USSWhite.h"
+#include "BoardV3.h"
+#include "GameRandom.h"
+#include "RunOptions.h"
+
+using namespace std;
+
+const int DensityTestRounds = 20;	// Rounds a pair of players plays in a row
+const int FleetShips = 6;		// Most ships AIContest deals.
+const int TimedTestRounds = 5;		// Timed rounds per board size
+
+long long shotsCompared = 0;
+long long timedShots = 0;
+
+/**
+ * @brief Places the fleet at random on board, starting over if the ships
+ * placed so far leave no room (small boards).
+ */
+void placeFleet( BoardV3* board, GameRandom& random, int size, const int lengths[], int numShips ) {
+    streambuf* old = cerr.rdbuf(NULL);	// placeShip() explains each spot that doesn't fit
+    int placed = 0;
+    while( placed < numShips ) {
+	board->clear();
+	for( placed=0; placed<numShips; placed++ ) {
+	    int tries = 0;
+	    while( tries < 100 && ! board->placeShip(random.below(size), random.below(size), lengths[placed],
+						   random.below(2) ? Horizontal : Vertical) ) {
+		tries++;
+	    }
+	    if( tries == 100 ) break;
+	}
+    }
+    cerr.rdbuf(old);
+}
+
+/**
+ * @brief Plays one round against a random fleet on both players at once.
+ * @return false if they picked different shots.
+ */
+bool playRound( USSWhite* players[2], uint64_t key, int size, int round, bool targeting ) {
+    GameRandom dealer(streamKey(key, RefereeStream));
+    GameRandom placer(streamKey(key, Player2Stream));
+    int numShips = size-2 < FleetShips ? size-2 : FleetShips;
+    BoardV3* board = BoardV3::create(size);
+    for( int p=0; p<2; p++ ) {
+	players[p]->seedRandom(streamKey(key, Player1Stream));
+	players[p]->newRound();
+    }
+    int lengths[FleetShips];
+    for( int i=0; i<numShips; i++ ) {
+	lengths[i] = dealer.below(MIN_SHIP_SIZE) + 3;
+	for( int p=0; p<2; p++ ) players[p]->nextPlacement(lengths[i]);
+    }
+    placeFleet(board, placer, size, lengths, numShips);
+
+    bool same = true;
+    for( int shots=0; shots < 2*size*size && ! board->hasWon(); shots++ ) {
+	Move shot[2];
+	for( int p=0; p<2; p++ ) shot[p] = players[p]->nextMove();
+	if( shot[0].row != shot[1].row || shot[0].col != shot[1].col ) {
+	    cout << "densitytest: board " << size << ", round " << round << ", fleet targeting "
+		 << (targeting ? "on" : "off") << ", shot " << shots << ": kept board shot at "
+		 << shot[0].row << "," << shot[0].col << ", recount at " << shot[1].row << "," << shot[1].col << endl;
+	    same = false;
+	    break;
+	}
+	shotsCompared++;
+	Move result = makeMove( board->processShot(shot[0].row, shot[0].col), shot[0].row, shot[0].col );
+	for( int p=0; p<2; p++ ) {
+	    if( result.type == KILL ) {
+		// As AIContest::processShot(): the HIT, then the whole ship.
+		ShipLocation ship = board->getShip(result.row, result.col);
+		players[p]->notify(makeMove( HIT, result.row, result.col ));
+		players[p]->notifyKill(makeMove( KILL, ship.row, ship.col, ship.dir, ship.length, ship.shipId ));
+	    } else {
+		players[p]->notify(result);
+	    }
+	}
+    }
+    delete board;
+    return same;
+}
+
+/**
+ * @brief Plays one round of player against a random fleet, checking only that
+ * every shot is a new cell on the board and that the fleet is sunk.
+ * @return false if not.
+ */
+bool playTimedRound( USSWhite* player, BoardV3* board, uint64_t key, int size, int round ) {
+    GameRandom dealer(streamKey(key, RefereeStream));
+    GameRandom placer(streamKey(key, Player2Stream));
+    int numShips = size-2 < FleetShips ? size-2 : FleetShips;
+    player->seedRandom(streamKey(key, Player1Stream));
+    player->newRound();
+    int lengths[FleetShips];
+    for( int i=0; i<numShips; i++ ) {
+	lengths[i] = dealer.below(MIN_SHIP_SIZE) + 3;
+	player->nextPlacement(lengths[i]);
+    }
+    placeFleet(board, placer, size, lengths, numShips);
+
+    bool shot[MAX_BOARD_SIZE][MAX_BOARD_SIZE] = {{false}};
+    for( int shots=0; shots < size*size && ! board->hasWon(); shots++ ) {
+	Move move = player->nextMove();
+	if( move.row < 0 || move.row >= size || move.col < 0 || move.col >= size || shot[move.row][move.col] ) {
+	    cout << "densitytest: board " << size << ", timed round " << round << ", shot " << shots
+		 << ": shot again or off the board at " << move.row << "," << move.col << endl;
+	    return false;
+	}
+	shot[move.row][move.col] = true;
+	timedShots++;
+	Move result = makeMove( board->processShot(move.row, move.col), move.row, move.col );
+	if( result.type == KILL ) {
+	    ShipLocation ship = board->getShip(result.row, result.col);
+	    player->notify(makeMove( HIT, result.row, result.col ));
+	    player->notifyKill(makeMove( KILL, ship.row, ship.col, ship.dir, ship.length, ship.shipId ));
+	} else {
+	    player->notify(result);
+	}
+    }
+    if( ! board->hasWon() ) {
+	cout << "densitytest: board " << size << ", timed round " << round << ": fleet not sunk" << endl;
+	return false;
+    }
+    return true;
+}
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    int rounds = options.totalGames > 0 ? options.totalGames : 100;
+    uint64_t seed = options.haveSeed ? options.seed : 1;
+
+    for( int targeting=0; targeting<2; targeting++ ) {
+	for( int size=5; size<=MAX_BOARD_SIZE; size++ ) {
+	    USSWhite* players[2] = { NULL, NULL };
+	    for( int round=0; round<rounds; round++ ) {
+		if( round % DensityTestRounds == 0 ) {
+		    for( int p=0; p<2; p++ ) {
+			delete players[p];
+			players[p] = new USSWhite(size);
+			players[p]->setShotModes(targeting, true, p == 1);
+		    }
+		}
+		uint64_t key = gameSeed(seed, targeting*(MAX_BOARD_SIZE+1) + size, round);
+		if( ! playRound(players, key, size, round, targeting) ) return 1;
+	    }
+	    for( int p=0; p<2; p++ ) delete players[p];
+	}
+    }
+
+    USSWhite::setTimedTargeting(true);
+    for( int size=5; size<=MAX_BOARD_SIZE; size++ ) {
+	USSWhite player(size);
+	BoardV3* board = BoardV3::create(size);
+	for( int round=0; round<TimedTestRounds; round++ ) {
+	    uint64_t key = gameSeed(seed, 2*(MAX_BOARD_SIZE+1) + size, round);
+	    if( ! playTimedRound(&player, board, key, size, round) ) return 1;
+	}
+	delete board;
+    }
+    USSWhite::setTimedTargeting(false);
+
+    cout << "densitytest: " << shotsCompared << " shots: the kept board picks the same shots as the recount; "
+	 << timedShots << " timed shots" << endl;
+    return 0;
+}
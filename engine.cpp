@@ -0,0 +1,198 @@
+/**
+ * engine.cpp: runs one player in its own process (see EngineProtocol.h).
+ * @author Mitchell Toth
+ * @date October, 2026
+ *
+ * Run by a driver's -x option, e.g.
+ *	./testAI -1 4 -2 6 -x "./engine -1 5"
+ * plays player 4 against player 5 running out of process. The engine's
+ * player is picked with -1 from PlayerTable.cpp (plugins may be loaded with
+ * -l); requests come on standard input and answers go to standard output.
+ *
+ * Requests are read in large chunks and answered from a buffer that is
+ * written just before the next read blocks, so a move costs one read and
+ * one write however many updates came with it. A player that prints to
+ * standard output would break the protocol, so its output goes to standard
+ * error instead.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+
+#include "PlayerV2.h"
+#include "PlayerV3.h"
+#include "Message.h"
+#include "Move.h"
+#include "EngineProtocol.h"
+#include "ThreadRandom.h"
+#include "RunOptions.h"
+#include "PlayerPlugins.h"
+#include "PlayerTable.h"
+
+using namespace std;
+
+int requestFd;			// Where requests come from
+int answerFd;			// Where answers go
+unsigned char answers[4096];
+int numAnswers = 0;		// Bytes in answers not written yet
+
+bool writeAnswers() {
+    int written = 0;
+    while( written < numAnswers ) {
+	ssize_t n = write(answerFd, answers + written, numAnswers - written);
+	if( n < 0 && errno == EINTR ) continue;
+	if( n <= 0 ) return false;
+	written += n;
+    }
+    numAnswers = 0;
+    return true;
+}
+
+void answer( EngineMessage type, const void* data, size_t size ) {
+    if( numAnswers + 1 + size > sizeof(answers) ) writeAnswers();
+    answers[numAnswers++] = (unsigned char)type;
+    memcpy(answers + numAnswers, data, size);
+    numAnswers += size;
+}
+
+/**
+ * @brief How long a request is, counting its code; 0 if the code is unknown.
+ */
+int requestSize( unsigned char type ) {
+    switch( type ) {
+	case EngineHello:	return 4;
+	case EngineSeed:	return 1 + 8;
+	case EngineNewRound:	return 1;
+	case EngineNotify:	return 1 + sizeof(Move);
+	case EngineNotifyKill:	return 1 + sizeof(Move);
+	case EnginePlace:	return 2;
+	case EngineGetMove:	return 1;
+	default:		return 0;
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    for( size_t i=0; i<options.plugins.size(); i++ ) {
+	if( ! loadPlayerPlugins(options.plugins[i]) ) return 1;
+    }
+    addPluginPlayers();
+    int playerId = options.player1;
+    if( playerId < 0 || playerId >= numPlayers() ) {
+	cerr << "Engine: pick a player with -1 (0-" << numPlayers()-1 << ")" << endl;
+	return 1;
+    }
+    string name = playerNames[playerId] + " engine";
+    if( name.size() > 255 ) name.resize(255);
+
+    // Keep the protocol's ends to ourselves; the player's prints go to cerr.
+    requestFd = dup(STDIN_FILENO);
+    answerFd = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+
+    PlayerV2* player = NULL;
+    PlayerV3* playerV3 = NULL;
+    unsigned char requests[65536];
+    int start = 0, end = 0;	// Unread requests are requests[start..end)
+    while( true ) {
+	// Handle every complete request we have.
+	while( end > start ) {
+	    unsigned char* request = requests + start;
+	    int size = requestSize(request[0]);
+	    if( size == 0 ) {
+		cerr << "Engine: unknown request '" << request[0] << "'" << endl;
+		return 1;
+	    }
+	    if( end - start < size ) break;
+	    start += size;
+
+	    Move move;
+	    if( size == 1 + (int)sizeof(Move) ) memcpy(&move, request + 1, sizeof(move));
+	    switch( request[0] ) {
+		case EngineHello: {
+		    if( request[1] != EngineProtocolVersion ) {
+			cerr << "Engine: protocol version " << (int)request[1]
+			     << "; this engine speaks " << EngineProtocolVersion << endl;
+			return 1;
+		    }
+		    int boardSize = request[2] | request[3] << 8;
+		    if( boardSize > 0 ) {
+			delete player;
+			player = getPlayer(playerId, boardSize);
+			playerV3 = dynamic_cast<PlayerV3*>(player);
+		    }
+		    unsigned char info[3 + 255];
+		    info[0] = (unsigned char)playerMaxBoardSizes[playerId];
+		    info[1] = (unsigned char)(playerMaxBoardSizes[playerId] >> 8);
+		    info[2] = (unsigned char)name.size();
+		    memcpy(info + 3, name.data(), name.size());
+		    answer(EngineInfo, info, 3 + name.size());
+		    break;
+		}
+		case EngineSeed: {
+		    uint64_t key = 0;
+		    for( int i=7; i>=0; i-- ) {
+			key = key << 8 | request[1+i];
+		    }
+		    // rand() here belongs to this player alone, so its stream will do.
+		    threadRandom::seed(key);
+		    if( playerV3 ) playerV3->seedRandom(key);
+		    break;
+		}
+		case EngineNewRound:
+		    if( player ) player->newRound();
+		    break;
+		case EngineNotify:
+		    if( playerV3 ) playerV3->notify(move);
+		    else if( player ) player->update(toMessage(move));
+		    break;
+		case EngineNotifyKill:
+		    if( playerV3 ) playerV3->notifyKill(move);
+		    else if( player ) {
+			for( int i=0; i<move.length; i++ ) {
+			    player->update(toMessage(killCell(move, i)));
+			}
+		    }
+		    break;
+		case EnginePlace:
+		    if( ! player ) return 1;
+		    if( playerV3 ) move = playerV3->nextPlacement(request[1]);
+		    else {
+			Message placement = player->placeShip(request[1]);
+			move = toMove(placement);
+		    }
+		    answer(EngineMove, &move, sizeof(move));
+		    break;
+		case EngineGetMove:
+		    if( ! player ) return 1;
+		    if( playerV3 ) move = playerV3->nextMove();
+		    else {
+			Message shot = player->getMove();
+			move = toMove(shot);
+		    }
+		    answer(EngineMove, &move, sizeof(move));
+		    break;
+	    }
+	}
+
+	// Answer before waiting for more.
+	if( ! writeAnswers() ) break;
+	if( start == end ) start = end = 0;
+	else if( start > 0 ) {
+	    memmove(requests, requests + start, end - start);
+	    end -= start;
+	    start = 0;
+	}
+	ssize_t n = read(requestFd, requests + end, sizeof(requests) - end);
+	if( n < 0 && errno == EINTR ) continue;
+	if( n <= 0 ) break;	// The referee is done with us
+	end += n;
+    }
+    delete player;
+    return 0;
+}
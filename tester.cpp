@@ -6,9 +6,12 @@
  *
  */
 
+#include <algorithm>
+#include <vector>
 #include <iostream>
 #include <iomanip>
 #include <cctype>
+#include <cmath>
 #include <unistd.h>
 
 // Next 2 to access and setup the random number generator.
@@ -20,22 +23,21 @@
 #include "AIContest.h"
 #include "PlayerV2.h"
 #include "conio.h"
+#include "RunOptions.h"
+#include "ReplayLog.h"
+#include "SequentialTest.h"
+#include "GameRandom.h"
+#include "PlayerPlugins.h"
 
-// Include your player here
-//	Professor's contestants
-#include "CleanPlayerV2.h"
-#include "SemiSmartPlayerV2.h"
-#include "GamblerPlayerV2.h"
-#include "LearningGambler.h"
+// The players to choose from (and your player) are listed in PlayerTable.cpp.
+#include "PlayerTable.h"
+#include "USSWhite.h"		// For setTimedTargeting()
 
-// Change to include your player directly below
-#include "USSWhite.h"
-
-
-PlayerV2* getPlayer( int playerId, int boardSize );
 void playMatch( int player1Id, int player2Id, bool showMoves, bool showAllRounds );
 int comparePlayers (const void * a, const void * b);
 int selectPlayer( string playerNames[], int NumPlayers, int selectionNumber );
+void printBatchSummary( int player1Num, int player2Num );
+void pairedDifference( double& difference, double& standardError, double& unpairedError );
 
 using namespace std;
 using namespace conio;
@@ -43,81 +45,176 @@ using namespace conio;
 float secondsPerMove = 1;
 int boardSize;	// BoardSize
 int totalGames = 0;
+uint64_t testSeed = 0;	// Game n is seeded with gameSeed(testSeed, 0, n).
 int totalCountedMoves = 0;
-const int NumPlayers = 5;
-
-int wins[NumPlayers][NumPlayers];
-int playerIds[NumPlayers];
-int lives[NumPlayers];
-int winCount[NumPlayers];
-int statsShotsTaken[NumPlayers];
-int statsGamesCounted[NumPlayers];
-string playerNames[NumPlayers] = { 
-    "Clean Player",
-    "Semi-Smart Player",
-    "Gambler Player",
-    "Learning Gambler",
-    // Change to your player's name below
-    "USSWhite"
-};
-
-int main() {
+bool batchMode = false;		// No display, no pauses, JSON summary at the end.
+ReplayWriter* replayLog = NULL;	// Every game is recorded here, if given (-r).
+SequentialTest earlyStop;	// Ends the match once the winner is settled (-e).
+bool pairedGames = false;	// Each game seed is played twice, sides swapped (-p).
+bool timedGames = false;	// Time every call (-t, -m, -M).
+double moveLimit = 0;		// Seconds; 0 = none (-m)
+double gameLimit = 0;		// Seconds; 0 = none (-M)
+bool pipelinedMoves = false;	// Player 2 moves while player 1 hears its result (-o).
+PlayerTiming matchTiming[2];	// Player 1's and player 2's calls, when timed
+
+// Sized once the plugins are loaded.
+vector< vector<int> > wins;
+vector<int> playerIds;
+vector<int> lives;
+vector<int> winCount;
+vector<int> statsShotsTaken;
+vector<int> statsGamesCounted;
+int matchTies = 0;
+int matchGames = 0;		// Games the match took; fewer than totalGames if it stopped early.
+
+// Paired mode scores each game +1 if player 1 won, -1 if player 2 won and 0
+// for a tie. Both games of a pair are dealt the same ships and use the same
+// random streams, each player taking the other's in the second, so the
+// pair's total varies less than two independent games would.
+struct PairedStats {
+    int pairs;
+    long pairSum, pairSquares;	// Of each pair's total score
+    int games;
+    long gameSum, gameSquares;	// Of each game's score on its own
+} paired = { 0, 0, 0, 0, 0, 0 };
+
+int main( int argc, char* argv[] ) {
     //bool silent = false;
 
+    // Settings may come from the command line or a config file (see RunOptions.h).
+    RunOptions options;
+    if( ! parseRunOptions(argc, argv, options) ) {
+	return 1;
+    }
+    batchMode = options.batch;
+    pairedGames = options.paired;
+    timedGames = options.timing;
+    moveLimit = options.moveLimit / 1000;
+    gameLimit = options.gameLimit / 1000;
+    pipelinedMoves = options.pipelined;
+    USSWhite::setTimedTargeting(options.timedTargeting);
+
+    // Player plugins, then engines, go after the built-in players (see PlayerPlugins.h).
+    for( size_t i=0; i<options.plugins.size(); i++ ) {
+	if( ! loadPlayerPlugins(options.plugins[i]) ) return 1;
+    }
+    for( size_t i=0; i<options.engines.size(); i++ ) {
+	if( ! loadEnginePlayer(options.engines[i]) ) return 1;
+    }
+    addPluginPlayers();
+    int NumPlayers = numPlayers();
+
     // Adjust based on the number of players!
     // Initialize various win statistics 
+    wins.assign(NumPlayers, vector<int>(NumPlayers, 0));
+    playerIds.resize(NumPlayers);
+    lives.resize(NumPlayers);
+    winCount.assign(NumPlayers, 0);
+    statsShotsTaken.assign(NumPlayers, 0);
+    statsGamesCounted.assign(NumPlayers, 0);
     for(int i=0; i<NumPlayers; i++) {
-	statsShotsTaken[i] = 0;
-	statsGamesCounted[i] = 0;
-	winCount[i] = 0;
 	lives[i] = NumPlayers/2;
 	playerIds[i] = i;
-	for(int j=0; j<NumPlayers; j++) {
-	    wins[i][j] = 0;
-    	}
     }
 
     // Seed (setup) the random number generator.
     // This should only happen once per program run.
-    srand(time(NULL));
+    testSeed = options.haveSeed ? options.seed : time(NULL);
+    srand(testSeed);
+
+    int player1Num, player2Num;
+    bool showAllRounds = options.showAllRounds;
+    if( batchMode ) {
+	// Batch mode never prompts: anything not given gets a default.
+	boardSize = options.boardSize > 0 ? options.boardSize : MAX_BOARD_SIZE;
+	totalGames = options.totalGames > 0 ? options.totalGames : 500;
+	secondsPerMove = 0;
+	showAllRounds = false;
+	player1Num = options.player1;
+	player2Num = options.player2;
+	if( boardSize < 3 || boardSize > MAX_LARGE_BOARD_SIZE ) {
+	    cerr << "Board size must be 3-" << MAX_LARGE_BOARD_SIZE << endl;
+	    return 1;
+	}
+	if( player1Num < 0 || player1Num >= NumPlayers || player2Num < 0 || player2Num >= NumPlayers ) {
+	    cerr << "Batch mode needs -1 and -2 player numbers (0-" << NumPlayers-1 << ")" << endl;
+	    return 1;
+	}
+    } else {
+	// Now to get the board size.
+	cout << "Welcome to the AI Bot tester." << endl << endl;
+	if( options.boardSize > 0 ) {
+	    boardSize = options.boardSize;
+	} else {
+	    cout << "What size board would you like? [Anything other than numbers 3-"
+		 << MAX_LARGE_BOARD_SIZE << " exits.] ";
+	    cin >> boardSize;
+	}
+	
+	// If have invalid board size input (non-number, or 0-2, or too big).
+	if ( !cin || boardSize < 3 || boardSize > MAX_LARGE_BOARD_SIZE ) {
+	    cout << "Exiting" << endl;
+	    return 1;
+	}
 
-    // Now to get the board size.
-    cout << "Welcome to the AI Bot tester." << endl << endl;
-    cout << "What size board would you like? [Anything other than numbers 3-10 exits.] ";
-    cin >> boardSize;
-    
-    // If have invalid board size input (non-number, or 0-2, or > 10).
-    if ( !cin || boardSize < 3 || boardSize > 10 ) {
-	cout << "Exiting" << endl;
-	return 1;
+	// Find out how many times to test the AI.
+	if( options.totalGames > 0 ) {
+	    totalGames = options.totalGames;
+	} else {
+	    cout << "How many times should I test the game AI? ";
+	    cin >> totalGames;
+	}
+
+	if( options.secondsPerMove >= 0 ) {
+	    secondsPerMove = options.secondsPerMove;
+	} else {
+	    cout << "The displayed games for each AI match are played at the specified speed." << endl
+		 << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
+	    cin >> secondsPerMove;
+
+	    // Find out whether to display all games
+	    cout << "Should all rounds be displayed (y|[N])? ";
+	    cin.ignore(100, '\n');
+	    char ans = cin.get();
+	    showAllRounds = ans=='Y' || ans=='y';
+	}
+
+	// Find out which AI's are to play
+	player1Num = options.player1 >= 0 ? options.player1 : selectPlayer( playerNames.data(), NumPlayers, 1 );
+	player2Num = options.player2 >= 0 ? options.player2 : selectPlayer( playerNames.data(), NumPlayers, 2 );
     }
 
-    // Find out how many times to test the AI.
-    cout << "How many times should I test the game AI? ";
-    cin >> totalGames;
+    if( pairedGames && totalGames % 2 ) {
+	totalGames++;	// Whole pairs only.
+    }
 
-    cout << "The displayed games for each AI match are played at the specified speed." << endl
-	 << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
-    cin >> secondsPerMove;
+    // Players with fixed-size arrays can't go past MAX_BOARD_SIZE.
+    for( int playerNum : { player1Num, player2Num } ) {
+	if( boardSize > playerMaxBoardSizes[playerNum] ) {
+	    cerr << playerNames[playerNum] << " plays boards up to " << playerMaxBoardSizes[playerNum] << endl;
+	    return 1;
+	}
+    }
 
-    // Find out whether to display all games
-    cout << "Should all rounds be displayed (y|[N])? ";
-    cin.ignore(100, '\n');
-    char ans = cin.get();
-    bool showAllRounds = ans=='Y' || ans=='y';
+    earlyStop = SequentialTest(options.stopError);
 
-    // Find out which AI's are to play
-    int player1Num = selectPlayer( playerNames, NumPlayers, 1 );
-    int player2Num = selectPlayer( playerNames, NumPlayers, 2 );
+    // Record the games if asked; deleting the writer flushes the file.
+    if( ! options.replayFile.empty() ) {
+	replayLog = new ReplayWriter(options.replayFile, playerNames.data(), NumPlayers);
+	if( ! replayLog->ok() ) return 1;
+    }
 
     // And now it's show time!
-    playMatch(player1Num, player2Num, true, showAllRounds);
-    usleep(3000000);	// Pause 3 seconds to let viewers see stats
-
-    cout << endl << endl;
+    playMatch(player1Num, player2Num, ! batchMode, showAllRounds);
+    delete replayLog;
+    replayLog = NULL;
+    if( ! batchMode ) {
+	usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	cout << endl << endl;
+    }
 
     // Now calculate contest results
-    qsort (playerIds, NumPlayers, sizeof(int), comparePlayers);
+    qsort (playerIds.data(), NumPlayers, sizeof(int), comparePlayers);
 
     // Add up the total wins per player
     for( int i=0; i<NumPlayers; i++ ) {
@@ -125,6 +222,11 @@ int main() {
 	    winCount[i]+= wins[i][j];
     }
 
+    if( batchMode ) {
+	printBatchSummary(player1Num, player2Num);
+	return 0;
+    }
+
     if( winCount[player1Num] > winCount[player2Num] ) {
 	cout << setTextStyle( BOLD );
     }
@@ -144,33 +246,54 @@ int main() {
 
 void playMatch( int player1Id, int player2Id, bool showMoves, bool showAllRounds ) {
     PlayerV2 *player1, *player2;
-    AIContest *game;
     int matchWins[2] = {0, 0};
     bool player1Won=false, player2Won=false;
     int player1Ties=0, player2Ties=0;
 
     player1 = getPlayer(player1Id, boardSize);
     player2 = getPlayer(player2Id, boardSize);
+    // One referee and pair of boards for all the rounds. In paired mode the
+    // second game of each pair replays the first's seed with the players'
+    // sides swapped: the same ships are dealt, and each player places them
+    // again drawing from the stream its opponent had, so the pair shares its
+    // luck but each player is still judged on its own placement.
+    AIContest game( player1, playerNames[player1Id],
+		    player2, playerNames[player2Id], boardSize );
+    game.setReplay(replayLog, player1Id, player2Id);
+    AIContest swappedGame( player2, playerNames[player2Id],
+			   player1, playerNames[player1Id], boardSize );
+    swappedGame.setReplay(replayLog, player2Id, player1Id);
+    if( timedGames ) {
+	game.setTiming(moveLimit, gameLimit, &matchTiming[0], &matchTiming[1]);
+	swappedGame.setTiming(moveLimit, gameLimit, &matchTiming[1], &matchTiming[0]);
+    }
+    if( ! game.setPipelined(pipelinedMoves) && pipelinedMoves ) {
+	cerr << "Only one core: moves are not pipelined" << endl;
+    }
+    swappedGame.setPipelined(pipelinedMoves);
 
     bool silent = true;
-    for( int count=0; count<totalGames; count++ ) {
+    int gamesToPlay = totalGames;
+    int pairScore = 0;
+    int count;
+    for( count=0; count<gamesToPlay; count++ ) {
 	player1Won = false; player2Won = false;
-	player1->newRound();
-	player2->newRound();
+	bool swapped = pairedGames && count % 2 == 1;
+	AIContest& contest = swapped ? swappedGame : game;
+	uint64_t seed = gameSeed(testSeed, 0, pairedGames ? count/2 : count);
 
-	if( count==totalGames-1 ) {
+	if( count==gamesToPlay-1 && showMoves ) {
 	    silent = false;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-				  boardSize, silent );
-	    game->play( secondsPerMove, totalCountedMoves, player1Won, player2Won );
+	    contest.reset( seed, silent );
+	    contest.play( secondsPerMove, totalCountedMoves, player1Won, player2Won );
 	} 
 	else {
 	    silent = showAllRounds==false;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-		      boardSize, silent );
-	    game->play( 0, totalCountedMoves, player1Won, player2Won );
+	    contest.reset( seed, silent, batchMode );
+	    contest.play( 0, totalCountedMoves, player1Won, player2Won );
+	}
+	if( swapped ) {
+	    swap(player1Won, player2Won);
 	}
 	if((player1Won && player2Won) || !(player1Won || player2Won)) {
 	    player1Ties++;
@@ -190,18 +313,57 @@ void playMatch( int player1Id, int player2Id, bool showMoves, bool showAllRounds
 	    statsShotsTaken[player2Id] += totalCountedMoves;
 	    statsGamesCounted[player2Id]++;
 	}
-	delete game;
+	if( pairedGames ) {
+	    int score = (int)player1Won - (int)player2Won;
+	    paired.games++;
+	    paired.gameSum += score;
+	    paired.gameSquares += score*score;
+	    pairScore += score;
+	    if( ! swapped ) continue;
+	    paired.pairs++;
+	    paired.pairSum += pairScore;
+	    paired.pairSquares += pairScore*pairScore;
+	    pairScore = 0;
+	}
+	// Once settled, stop; a watched match still gets its displayed last
+	// game (or pair).
+	if( gamesToPlay == totalGames && earlyStop.settled(matchWins[0], matchWins[1]) ) {
+	    int shown = showMoves ? (pairedGames ? 2 : 1) : 0;
+	    gamesToPlay = min(totalGames, count+1 + shown);
+	}
     }
     delete player1;
     delete player2;
+    matchTies = player1Ties;
+    matchGames = count;
+
+    if( batchMode ) return;
 
     cout << endl << "********************" << endl;
     cout << playerNames[player1Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[0] << resetAll()
-	 << " losses=" << totalGames-matchWins[0]-player1Ties 
+	 << " losses=" << matchGames-matchWins[0]-player1Ties 
 	 << " ties=" << player1Ties << endl;
     cout << playerNames[player2Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[1] << resetAll()
-	 << " losses=" << totalGames-matchWins[1]-player2Ties 
+	 << " losses=" << matchGames-matchWins[1]-player2Ties 
 	 << " ties=" << player2Ties << endl;
+    cout << "Games played=" << matchGames << " of " << totalGames << ", confidence in the leader="
+	 << (int)(1000 * SequentialTest::confidence(matchWins[0], matchWins[1]) + 0.5) / 10.0 << "%" << endl;
+    if( pairedGames ) {
+	double difference, standardError, unpairedError;
+	pairedDifference(difference, standardError, unpairedError);
+	cout << "Paired difference per game=" << showpos << difference << noshowpos
+	     << " +/- " << standardError << " (unpaired +/- " << unpairedError << ")"
+	     << " over " << paired.pairs << " pairs" << endl;
+    }
+    if( timedGames ) {
+	int ids[2] = { player1Id, player2Id };
+	for( int side=0; side<2; side++ ) {
+	    const PlayerTiming& timing = matchTiming[side];
+	    cout << playerNames[ids[side]] << ": getMove " << timing.getMove.toText()
+		 << "; update " << timing.update.toText()
+		 << "; late moves=" << timing.lateMoves << " time forfeits=" << timing.timeForfeits << endl;
+	}
+    }
     cout << "********************" << endl;
 }
 
@@ -217,17 +379,48 @@ int comparePlayers (const void * a, const void * b) {
     }
 }
 
-PlayerV2* getPlayer( int playerId, int boardSize ) {
-    switch( playerId ) {
-	// Professor provided
-	default:
-	case 0: return new CleanPlayerV2( boardSize );
-	case 1: return new SemiSmartPlayerV2( boardSize );
-	case 2: return new GamblerPlayerV2( boardSize );
-	case 3: return new LearningGambler( boardSize );
-	// Change for your player's AI below
-	case 4: return new USSWhite( boardSize );
+/**
+ * Player 1's wins less player 2's, per game, with its standard error from the
+ * spread of the pairs, and what the error would be if the games had been
+ * independent. Errors are 0 until there are two pairs.
+ */
+void pairedDifference( double& difference, double& standardError, double& unpairedError ) {
+    difference = standardError = unpairedError = 0;
+    if( paired.pairs == 0 ) return;
+    difference = (double)paired.pairSum / (2 * paired.pairs);
+    if( paired.pairs < 2 ) return;
+    double n = paired.pairs;
+    double pairVariance = (paired.pairSquares - paired.pairSum * (double)paired.pairSum / n) / (n - 1);
+    standardError = sqrt(pairVariance / n) / 2;
+    double m = paired.games;
+    double gameVariance = (paired.gameSquares - paired.gameSum * (double)paired.gameSum / m) / (m - 1);
+    unpairedError = sqrt(gameVariance / m);
+}
+
+/**
+ * Prints the match result as one JSON object.
+ */
+void printBatchSummary( int player1Num, int player2Num ) {
+    int players[2] = { player1Num, player2Num };
+    cout << "{\"boardSize\":" << boardSize << ",\"games\":" << matchGames << ",\"players\":[";
+    for( int i=0; i<2; i++ ) {
+	int id = players[i];
+	cout << (i ? "," : "") << "{\"player\":" << jsonString(playerNames[id])
+	     << ",\"wins\":" << wins[id][players[1-i]]
+	     << ",\"shotsTaken\":" << statsShotsTaken[id] << ",\"gamesCounted\":" << statsGamesCounted[id];
+	if( timedGames ) cout << ",\"timing\":" << matchTiming[i].toJson();
+	cout << "}";
+    }
+    cout << "],\"ties\":" << matchTies
+	 << ",\"confidence\":" << SequentialTest::confidence(wins[player1Num][player2Num], wins[player2Num][player1Num])
+	 << ",\"stoppedEarly\":" << (matchGames < totalGames ? "true" : "false");
+    if( pairedGames ) {
+	double difference, standardError, unpairedError;
+	pairedDifference(difference, standardError, unpairedError);
+	cout << ",\"paired\":{\"pairs\":" << paired.pairs << ",\"difference\":" << difference
+	     << ",\"standardError\":" << standardError << ",\"unpairedStandardError\":" << unpairedError << "}";
     }
+    cout << "}" << endl;
 }
 
 int selectPlayer( string playerNames[], int NumPlayers, int selectionNumber ) {